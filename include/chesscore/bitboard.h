@@ -9,6 +9,9 @@
 
 #include <array>
 #include <cstdint>
+#include <initializer_list>
+#include <optional>
+#include <type_traits>
 
 #include "chesscore/bitmap.h"
 #include "chesscore/board.h"
@@ -19,11 +22,72 @@
 
 namespace chesscore {
 
+/**
+ * \brief Which moves a move generator emits.
+ */
+enum class GenerationMode {
+    Legal,      ///< Only legal moves.
+    PseudoLegal ///< Moves that may leave the own king in check; check them with Bitboard::is_legal_after_pseudo().
+};
+
+namespace detail {
+
+/**
+ * \brief Color dependent constants for the move generation.
+ *
+ * The generators for pawn moves and castling are templates on the moving
+ * color, so these constants are folded at compile time.
+ * \tparam C The moving color.
+ */
+template<Color C>
+struct ColorTraits {
+    static constexpr Color opponent = C == Color::White ? Color::Black : Color::White;
+    static constexpr int forward = C == Color::White ? 1 : -1; ///< Rank direction of pawn moves.
+    static constexpr int back_rank = C == Color::White ? Rank::min_rank : Rank::max_rank;
+    static constexpr int promotion_rank = C == Color::White ? Rank::max_rank : Rank::min_rank;
+    static constexpr int double_step_rank = C == Color::White ? Rank::white_pawn_double_step_rank : Rank::black_pawn_double_step_rank;
+    static constexpr std::uint8_t kingside_right = C == Color::White ? CastlingRights::WhiteKingside : CastlingRights::BlackKingside;
+    static constexpr std::uint8_t queenside_right = C == Color::White ? CastlingRights::WhiteQueenside : CastlingRights::BlackQueenside;
+};
+
+/**
+ * \brief Target squares of the pawns of the player to move.
+ */
+struct PawnTargets {
+    Bitmap single_steps;  ///< Targets of single step pushes.
+    Bitmap double_steps;  ///< Targets of double step pushes.
+    Bitmap west_captures; ///< Targets of captures towards the a-file (including en passant).
+    Bitmap east_captures; ///< Targets of captures towards the h-file (including en passant).
+};
+
+/**
+ * \brief Hand a generated move to a visitor.
+ *
+ * \tparam Visitor Callable with a `const Move &` parameter, returning \c void
+ *         or \c bool.
+ * \param visitor The visitor.
+ * \param move The generated move.
+ * \return If the generation continues, i.e. the visitor did not return \c false.
+ */
+template<typename Visitor>
+constexpr auto visit_move(Visitor &visitor, const Move &move) -> bool {
+    if constexpr (std::is_same_v<std::invoke_result_t<Visitor &, const Move &>, bool>) {
+        return visitor(move);
+    } else {
+        visitor(move);
+        return true;
+    }
+}
+
+} // namespace detail
+
 /**
  * \brief A bitboard stores the placement of pieces on the board.
  *
  * The bitboard contains Bitmaps that describe the placement of figures on the
- * chess board.
+ * chess board. There is one Bitmap for each piece type and one for each color;
+ * the pieces of a certain type and color are the intersection of both. This
+ * keeps the board at 64 bytes, so that it can be copied cheaply.
  */
 class Bitboard {
 public:
@@ -125,7 +189,8 @@ public:
      * \brief Make a move.
      *
      * Assumes, that the given move is valid in the current position. No checks
-     * are performed!
+     * are performed! The captured piece of the move has to be set correctly,
+     * as only the bitmaps of the moving and the captured piece are updated.
      * \param move The move to apply in the current position.
      */
     auto make_move(const Move &move) -> void;
@@ -164,6 +229,103 @@ public:
      */
     auto capture_moves(const PositionState &state) const -> MoveList;
 
+    /**
+     * \brief Generate all pseudo-legal moves.
+     *
+     * Generates the moves without testing, if they leave the own king in
+     * check. A search can test only the moves it actually tries with
+     * is_legal_after_pseudo(). Castling moves are always legal, and in double
+     * check only king moves are generated.
+     * \param state State of the current position.
+     * \return A list of all pseudo-legal moves for the given position and player.
+     */
+    auto all_pseudo_legal_moves(const PositionState &state) const -> MoveList;
+
+    /**
+     * \brief Check a pseudo-legal move for legality.
+     *
+     * Tests, if a move generated in GenerationMode::PseudoLegal leaves the own
+     * king in check. Uses the pin and check information of the state.
+     * \param move The pseudo-legal move.
+     * \param state State of the current position.
+     * \return If the move is legal.
+     */
+    auto is_legal_after_pseudo(const Move &move, const PositionState &state) const -> bool { return is_legal_move(move, state); }
+
+    /**
+     * \brief Check, if the player to move has a legal move.
+     *
+     * Stops at the first legal move. The cheapest candidates are tried first:
+     * king moves, then captures of a single checking piece, then the remaining
+     * pieces. Castling is never tried, because a legal castling move implies a
+     * legal king step towards the rook.
+     * \param state State of the current position.
+     * \return If there is at least one legal move.
+     */
+    auto has_legal_move(const PositionState &state) const -> bool;
+
+    /**
+     * \brief Check, if a move could be made on the board, ignoring checks.
+     *
+     * Validates a move of unknown origin, e.g. from a transposition table, a
+     * killer slot or user input, without generating moves. The moving piece
+     * has to stand on the start square, the captured and promoted pieces have
+     * to match the board, and the piece has to be able to reach the target
+     * square. Castling moves are fully validated, including attacked squares.
+     * The information for unmaking the move is not checked.
+     * \param move The move.
+     * \param state State of the current position.
+     * \return If the move is pseudo-legal.
+     */
+    auto is_pseudo_legal(const Move &move, const PositionState &state) const -> bool;
+
+    /**
+     * \brief Check, if a move is legal.
+     *
+     * Like is_pseudo_legal(), but additionally checks that the move does not
+     * leave the own king in check. Uses the check information of the state.
+     * \param move The move.
+     * \param state State of the current position.
+     * \return If the move is legal.
+     */
+    auto is_legal(const Move &move, const PositionState &state) const -> bool;
+
+    /**
+     * \brief Check, if a move gives check.
+     *
+     * Answers without making the move: the moved piece (or the promoted piece,
+     * or the rook of a castling move) may attack the opposing king from its
+     * target square, or the move may uncover an attack of a sliding piece. En
+     * passant captures uncover two squares at once. Uses the cached check
+     * information of the state, if it is available for the moving player.
+     * \param move The move; it has to be legal.
+     * \param state State of the current position.
+     * \return If the move puts the opposing king in check.
+     */
+    auto gives_check(const Move &move, const PositionState &state) const -> bool;
+
+    /**
+     * \brief Hand all legal moves to a visitor.
+     *
+     * Generates the same moves as all_legal_moves(), but calls the visitor for
+     * each move instead of building a list. This allows counting moves or
+     * searching for a particular move without storing them. If the visitor
+     * returns \c bool, returning \c false stops the generation: the generators
+     * are instantiated for the visitor's type and return right away.
+     * \tparam Visitor Callable with a `const Move &` parameter.
+     * \param state State of the current position.
+     * \param visitor The visitor.
+     * \param mode Generate legal or pseudo-legal moves.
+     * \return If all moves were generated, i.e. the visitor did not stop early.
+     */
+    template<typename Visitor>
+    auto generate(const PositionState &state, Visitor &&visitor, GenerationMode mode = GenerationMode::Legal) const -> bool {
+        if (mode == GenerationMode::PseudoLegal) {
+            return legal_moves<GenerationMode::PseudoLegal>(state, visitor);
+        }
+        return legal_moves<GenerationMode::Legal>(state, visitor);
+    }
+
     /**
      * \brief Generate all moves for all knights.
      *
@@ -238,6 +400,37 @@ public:
      */
     auto find_king(Color color) const -> std::optional<Square>;
 
+    /**
+     * \brief The squares occupied by pieces of a type.
+     *
+     * \param piece_type The piece type.
+     * \return The squares with pieces of the type, of both colors.
+     */
+    auto bitmap(const PieceType &piece_type) const -> const Bitmap & { return m_piece_types[get_index(piece_type)]; }
+
+    /**
+     * \brief The squares occupied by a piece.
+     *
+     * \param piece The piece.
+     * \return The squares with the given piece.
+     */
+    auto bitmap(const Piece &piece) const -> Bitmap { return bitmap(piece.type) & bitmap(piece.color); }
+
+    /**
+     * \brief The squares occupied by pieces of a color.
+     *
+     * \param color The color.
+     * \return The squares with pieces of the color.
+     */
+    auto bitmap(const Color &color) const -> const Bitmap & { return m_colors[get_index(color)]; }
+
+    /**
+     * \brief The occupied squares.
+     *
+     * \return The squares with a piece of any color.
+     */
+    auto occupied() const -> Bitmap { return m_colors[0] | m_colors[1]; }
+
     /**
      * \brief Check, if a square is under attack.
      *
@@ -248,6 +441,28 @@ public:
      */
     auto is_attacked(const Square &square, Color attacker_color) const -> bool;
 
+    /**
+     * \brief All pieces attacking a square.
+     *
+     * Collects the pieces of both colors that attack the given square. The
+     * occupancy decides which squares block sliding pieces, so attacks can be
+     * computed for hypothetical boards, e.g. with some pieces removed. The
+     * attacking pieces themselves are taken from the board; mask the result
+     * with the occupancy to drop removed pieces.
+     * \param square The attacked square.
+     * \param occupancy The occupied squares.
+     * \return The squares of all attacking pieces.
+     */
+    auto attackers_to(const Square &square, const Bitmap &occupancy) const -> Bitmap;
+
+    /**
+     * \brief All pieces attacking a square on the current board.
+     *
+     * \param square The attacked square.
+     * \return The squares of all attacking pieces of both colors.
+     */
+    auto attackers_to(const Square &square) const -> Bitmap { return attackers_to(square, occupied()); }
+
     /**
      * \brief Check, if a square would be under attack after a move.
      *
@@ -296,6 +511,117 @@ public:
      */
     auto sliding_piece_attacks(const Square &square, Color piece_color) const -> bool;
 
+    /**
+     * \brief Squares attacked by a piece.
+     *
+     * Looks up the squares a piece on the given square attacks on the current
+     * board, without generating moves. Squares occupied by pieces of either
+     * color are included, so the result also covers defended pieces.
+     * \param piece The attacking piece.
+     * \param square The square of the piece.
+     * \return The attacked squares.
+     */
+    auto attacks(const Piece &piece, const Square &square) const -> Bitmap;
+
+    /**
+     * \brief Squares attacked by all pieces of a kind.
+     *
+     * \param piece The kind of attacking pieces (type and color).
+     * \return The union of the squares attacked by the pieces.
+     */
+    auto attacks_by(const Piece &piece) const -> Bitmap;
+
+    /**
+     * \brief Squares attacked by all pieces of a color.
+     *
+     * \param color The color of the attacking pieces.
+     * \return The union of the squares attacked by the pieces.
+     */
+    auto attacks_by(Color color) const -> Bitmap;
+
+    /**
+     * \brief Mobility of all pieces of a kind.
+     *
+     * Counts the attacked squares of each piece of the given kind that lie in
+     * the given set of squares, e.g. squares not occupied by own pieces and not
+     * attacked by opposing pawns, and sums them up.
+     * \param piece The kind of pieces (type and color).
+     * \param area The squares that count.
+     * \return The summed mobility.
+     */
+    auto mobility(const Piece &piece, const Bitmap &area) const -> int;
+
+    /**
+     * \brief Pieces blocking sliding attacks on a square.
+     *
+     * Finds the pieces of both colors that are the only piece between the
+     * given square and a rook, bishop or queen of the given color, that would
+     * attack the square if the blocking piece was removed.
+     * \param square The square shielded by the blockers.
+     * \param slider_color Color of the sliding pieces.
+     * \return The blocking pieces.
+     */
+    auto slider_blockers(const Square &square, Color slider_color) const -> Bitmap;
+
+    /**
+     * \brief Absolutely pinned pieces.
+     *
+     * The pieces of the given color that are the only piece between their king
+     * and an opposing sliding piece. They may only move along the line between
+     * the king and the pinning piece.
+     * \param king_square Square of the king.
+     * \param color Color of the king and the pinned pieces.
+     * \return The pinned pieces.
+     */
+    auto pinned_pieces(const Square &king_square, Color color) const -> Bitmap;
+
+    /**
+     * \brief Pieces pinning pieces to a king.
+     *
+     * The opposing sliding pieces that pin a piece of the given color to the
+     * king on the given square.
+     * \param king_square Square of the king.
+     * \param color Color of the king and the pinned pieces.
+     * \return The pinning pieces.
+     */
+    auto pinners(const Square &king_square, Color color) const -> Bitmap;
+
+    /**
+     * \brief Candidates for discovered checks.
+     *
+     * The pieces of the given color that block an attack of one of their own
+     * sliding pieces on the opposing king. Moving such a piece off the line
+     * gives a discovered check.
+     * \param color Color of the player giving check.
+     * \return The candidate pieces; empty, if there is no opposing king.
+     */
+    auto discovered_check_candidates(Color color) const -> Bitmap;
+
+    /**
+     * \brief X-ray attacks of a sliding piece through another piece.
+     *
+     * Computes the squares a sliding piece of the given type on the given
+     * square would additionally attack, if the piece on the \p through square
+     * was transparent.
+     * \param square Square of the sliding piece.
+     * \param slider_type Type of the sliding piece (rook, bishop or queen).
+     * \param through The square of the piece to look through.
+     * \return The squares attacked only through the given piece.
+     */
+    auto xray_attacks(const Square &square, PieceType slider_type, const Square &through) const -> Bitmap;
+
+    /**
+     * \brief Compute the cached check information of a position.
+     *
+     * Determines the squares of both kings, the pieces that give check to the
+     * king of the player to move, the pieces blocking sliding attacks on both
+     * kings and the squares from which the player to move could check the
+     * opposing king. The results are stored in the given state, so that move
+     * generation and check tests can use them without scanning the board.
+     * \param state The state to update.
+     */
+    auto update_check_info(PositionState &state) const -> void;
+
     /**
      * \brief Comparison of two Bitboards.
      *
@@ -304,46 +630,255 @@ public:
      */
     auto operator==(const Bitboard &rhs) const -> bool;
 private:
-    std::array<Bitmap, 12> m_bitmaps{};
-    Bitmap m_white_pieces{};
-    Bitmap m_black_pieces{};
-    Bitmap m_all_pieces{};
+    std::array<Bitmap, piece_type_count> m_piece_types{}; ///< Pieces of each type (both colors).
+    std::array<Bitmap, 2> m_colors{};                     ///< Pieces of each color.
 
     enum class PawnCaptureDirection { West, East };
 
-    auto bitmap_index(const Piece &piece) const -> size_t {
-        const auto type_index = static_cast<unsigned int>(piece.type);
-        const auto color_offset = (piece.color == Color::White) ? 0U : 6U;
-        return type_index + color_offset;
-    }
-
-    auto bitmap(const Piece &piece) const -> const Bitmap & { return m_bitmaps[bitmap_index(piece)]; }
-    auto bitmap(const Piece &piece) -> Bitmap & { return m_bitmaps[bitmap_index(piece)]; }
-    auto bitmap(const Color &color) const -> const Bitmap & { return color == Color::White ? m_white_pieces : m_black_pieces; }
-    auto bitmap(const Color &color) -> Bitmap & { return color == Color::White ? m_white_pieces : m_black_pieces; }
-
-    void move_castling_rook(const Move &move);
-    void reset_castling_rook(const Move &move);
+    auto toggle_piece(const Piece &piece, const Bitmap &squares) -> void;
+    auto toggle_castling_rook(const Move &move) -> void;
 
-    auto remove_occupied_squares(const Bitmap &bitmap) const -> Bitmap;
-
-    auto all_stepping_moves(PieceType piece_type, MoveList &moves, const PositionState &state) const -> void;
     auto all_targets_along_ray(const Square &start, Color moving_color, const RayDirection &direction) const -> Bitmap;
-    auto sliding_moves_for_type(PieceType piece_type, MoveList &moves, const PositionState &state) const -> void;
+    auto stepping_targets(PieceType piece_type, const Square &square, Color moving_color) const -> Bitmap;
+    auto pawn_targets(const PositionState &state) const -> detail::PawnTargets;
     auto attacked_from_ray(const Square &square, Color piece_color, RayDirection direction, PieceType attacker1, PieceType attacker2) const -> bool;
-
-    auto extract_moves(Bitmap targets, const Square &from, const Piece &piece, const PositionState &state, MoveList &moves) const -> void;
-    auto extract_pawn_moves(Bitmap targets, int step_size, const PositionState &state, MoveList &moves) const -> void;
-    auto extract_pawn_captures(Bitmap targets, PawnCaptureDirection direction, const PositionState &state, MoveList &moves) const -> void;
-    auto generate_pawn_moves(const Square &source, const Square &target, std::optional<Piece> captured, bool en_passant, const PositionState &state, MoveList &moves) const -> void;
+    auto attackers_of(const Square &square, Color attacker_color) const -> Bitmap;
+    auto snipers(const Square &square, Color slider_color) const -> Bitmap;
+    auto attacks(const Piece &piece, const Square &square, const Bitmap &occupancy) const -> Bitmap;
+
+    template<Color C>
+    auto pawn_attacks(const Square &square) const -> bool;
+
+    // The generators return false, as soon as the visitor stopped the generation.
+    template<GenerationMode Mode, typename Visitor>
+    auto legal_moves(const PositionState &state, Visitor &visitor) const -> bool;
+    template<GenerationMode Mode, Color C, typename Visitor>
+    auto legal_moves(const PositionState &state, Visitor &visitor) const -> bool;
+    template<GenerationMode Mode, typename Visitor>
+    auto stepping_moves(PieceType piece_type, const PositionState &state, Visitor &visitor) const -> bool;
+    template<GenerationMode Mode, typename Visitor>
+    auto sliding_moves(const PositionState &state, Visitor &visitor) const -> bool;
+    template<GenerationMode Mode, typename Visitor>
+    auto sliding_piece_moves(const Piece &moving_piece, const Square &start, const PositionState &state, Visitor &visitor) const -> bool;
+    template<GenerationMode Mode, Color C, typename Visitor>
+    auto pawn_moves(const PositionState &state, Visitor &visitor) const -> bool;
+
+    template<GenerationMode Mode, typename Visitor>
+    auto extract_moves(Bitmap targets, const Square &from, const Piece &piece, const PositionState &state, Visitor &visitor) const -> bool;
+    template<GenerationMode Mode, Color C, typename Visitor>
+    auto extract_pawn_moves(Bitmap targets, int step_size, const PositionState &state, Visitor &visitor) const -> bool;
+    template<GenerationMode Mode, Color C, typename Visitor>
+    auto extract_pawn_captures(Bitmap targets, PawnCaptureDirection direction, const PositionState &state, Visitor &visitor) const -> bool;
+    template<GenerationMode Mode, Color C, typename Visitor>
+    auto generate_pawn_moves(const Square &source, const Square &target, std::optional<Piece> captured, bool en_passant, const PositionState &state, Visitor &visitor) const -> bool;
+    template<GenerationMode Mode, Color C, typename Visitor>
     auto generate_pawn_move(
-        const Square &source, const Square &target, std::optional<Piece> captured, bool en_passant, std::optional<Piece> promoted, const PositionState &state, MoveList &moves
-    ) const -> void;
-    auto generate_castling_moves(MoveList &moves, const PositionState &state) const -> void;
-
-    auto store_move_if_legal(const Move &move, MoveList &moves) const -> void;
+        const Square &source, const Square &target, std::optional<Piece> captured, bool en_passant, std::optional<Piece> promoted, const PositionState &state, Visitor &visitor
+    ) const -> bool;
+    template<Color C, typename Visitor>
+    auto generate_castling_moves(const PositionState &state, Visitor &visitor) const -> bool;
+
+    template<GenerationMode Mode, typename Visitor>
+    auto visit_if_legal(const Move &move, const PositionState &state, Visitor &visitor) const -> bool;
+    auto is_legal_move(const Move &move, const PositionState &state) const -> bool;
 };
 
+template<GenerationMode Mode, typename Visitor>
+auto Bitboard::legal_moves(const PositionState &state, Visitor &visitor) const -> bool {
+    if (state.side_to_move == Color::White) {
+        return legal_moves<Mode, Color::White>(state, visitor);
+    }
+    return legal_moves<Mode, Color::Black>(state, visitor);
+}
+
+template<GenerationMode Mode, Color C, typename Visitor>
+auto Bitboard::legal_moves(const PositionState &state, Visitor &visitor) const -> bool {
+    if (state.has_check_info() && state.checkers.count() > 1) {
+        // in double check, only the king can move
+        return stepping_moves<Mode>(PieceType::King, state, visitor);
+    }
+    return stepping_moves<Mode>(PieceType::Knight, state, visitor) && stepping_moves<Mode>(PieceType::King, state, visitor) && generate_castling_moves<C>(state, visitor) &&
+           sliding_moves<Mode>(state, visitor) && pawn_moves<Mode, C>(state, visitor);
+}
+
+template<GenerationMode Mode, typename Visitor>
+auto Bitboard::stepping_moves(PieceType piece_type, const PositionState &state, Visitor &visitor) const -> bool {
+    const auto piece = Piece{.type = piece_type, .color = state.side_to_move};
+    for (const auto square : bitmap(piece)) {
+        if (!extract_moves<Mode>(stepping_targets(piece_type, square, state.side_to_move), square, piece, state, visitor)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+template<GenerationMode Mode, typename Visitor>
+auto Bitboard::sliding_moves(const PositionState &state, Visitor &visitor) const -> bool {
+    for (const auto piece_type : {PieceType::Queen, PieceType::Bishop, PieceType::Rook}) {
+        const auto piece = Piece{.type = piece_type, .color = state.side_to_move};
+        for (const auto square : bitmap(piece)) {
+            if (!sliding_piece_moves<Mode>(piece, square, state, visitor)) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+template<GenerationMode Mode, typename Visitor>
+auto Bitboard::sliding_piece_moves(const Piece &moving_piece, const Square &start, const PositionState &state, Visitor &visitor) const -> bool {
+    const auto ray_directions_for_piece = piece_ray_directions[moving_piece.type];
+    for (auto direction : all_ray_directions) {
+        if ((ray_directions_for_piece & direction) != 0 && !extract_moves<Mode>(all_targets_along_ray(start, state.side_to_move, direction), start, moving_piece, state, visitor)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+template<GenerationMode Mode, Color C, typename Visitor>
+auto Bitboard::pawn_moves(const PositionState &state, Visitor &visitor) const -> bool {
+    const auto targets = pawn_targets(state);
+    return extract_pawn_moves<Mode, C>(targets.single_steps, 1, state, visitor) && extract_pawn_moves<Mode, C>(targets.double_steps, 2, state, visitor) &&
+           extract_pawn_captures<Mode, C>(targets.west_captures, PawnCaptureDirection::West, state, visitor) &&
+           extract_pawn_captures<Mode, C>(targets.east_captures, PawnCaptureDirection::East, state, visitor);
+}
+
+template<GenerationMode Mode, typename Visitor>
+auto Bitboard::extract_moves(Bitmap targets, const Square &from, const Piece &piece, const PositionState &state, Visitor &visitor) const -> bool {
+    for (const auto target_square : targets) {
+        const Move move{
+            .from = from,
+            .to = target_square,
+            .piece = piece,
+            .captured = get_piece(target_square),
+            .capturing_en_passant = false,
+            .promoted = {},
+            .castling_rights_before = state.castling_rights,
+            .halfmove_clock_before = state.halfmove_clock,
+            .en_passant_target_before = state.en_passant_target
+        };
+        if (!visit_if_legal<Mode>(move, state, visitor)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+template<GenerationMode Mode, Color C, typename Visitor>
+auto Bitboard::extract_pawn_moves(Bitmap targets, int step_size, const PositionState &state, Visitor &visitor) const -> bool {
+    for (const auto target_square : targets) {
+        const auto source_square = Square::from_index(static_cast<std::size_t>(static_cast<int>(target_square.index()) - detail::ColorTraits<C>::forward * File::max_file * step_size));
+        if (!generate_pawn_moves<Mode, C>(source_square, target_square, std::nullopt, false, state, visitor)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+template<GenerationMode Mode, Color C, typename Visitor>
+auto Bitboard::extract_pawn_captures(Bitmap targets, PawnCaptureDirection direction, const PositionState &state, Visitor &visitor) const -> bool {
+    for (const auto target_square : targets) {
+        const auto source_square = Square{
+            File{direction == PawnCaptureDirection::East ? target_square.file().file - 1 : target_square.file().file + 1},
+            Rank{target_square.rank().rank - detail::ColorTraits<C>::forward},
+        };
+        const auto captured = get_piece(target_square);
+        if (!generate_pawn_moves<Mode, C>(
+                source_square, target_square, captured.value_or(Piece{.type = PieceType::Pawn, .color = detail::ColorTraits<C>::opponent}), !captured.has_value(), state, visitor
+            )) {
+            return false;
+        }
+    }
+    return true;
+}
+
+template<GenerationMode Mode, Color C, typename Visitor>
+auto Bitboard::generate_pawn_moves(const Square &source, const Square &target, std::optional<Piece> captured, bool en_passant, const PositionState &state, Visitor &visitor) const
+    -> bool {
+    if (target.rank().rank == detail::ColorTraits<C>::promotion_rank) {
+        for (const auto &type : all_promotion_piece_types) {
+            if (!generate_pawn_move<Mode, C>(source, target, captured, en_passant, Piece{.type = type, .color = C}, state, visitor)) {
+                return false;
+            }
+        }
+        return true;
+    }
+    return generate_pawn_move<Mode, C>(source, target, captured, en_passant, std::nullopt, state, visitor);
+}
+
+template<GenerationMode Mode, Color C, typename Visitor>
+auto Bitboard::generate_pawn_move(
+    const Square &source, const Square &target, std::optional<Piece> captured, bool en_passant, std::optional<Piece> promoted, const PositionState &state, Visitor &visitor
+) const -> bool {
+    return visit_if_legal<Mode>(
+        Move{
+            .from = source,
+            .to = target,
+            .piece = Piece{.type = PieceType::Pawn, .color = C},
+            .captured = captured,
+            .capturing_en_passant = en_passant,
+            .promoted = promoted,
+            .castling_rights_before = state.castling_rights,
+            .halfmove_clock_before = state.halfmove_clock,
+            .en_passant_target_before = state.en_passant_target
+        },
+        state, visitor
+    );
+}
+
+template<Color C, typename Visitor>
+auto Bitboard::generate_castling_moves(const PositionState &state, Visitor &visitor) const -> bool {
+    constexpr auto opponent = detail::ColorTraits<C>::opponent;
+    constexpr Rank back_rank{detail::ColorTraits<C>::back_rank};
+    constexpr Square king_square{File{'E'}, back_rank};
+    const auto castling_move = [&state](const Square &target) {
+        return Move{
+            .from = king_square,
+            .to = target,
+            .piece = Piece{.type = PieceType::King, .color = C},
+            .captured = {},
+            .capturing_en_passant = false,
+            .promoted = {},
+            .castling_rights_before = state.castling_rights,
+            .halfmove_clock_before = state.halfmove_clock,
+            .en_passant_target_before = state.en_passant_target
+        };
+    };
+    // castling moves are only generated, if they are legal
+    if (state.castling_rights.has(detail::ColorTraits<C>::kingside_right)) {
+        constexpr Square f_square{File{'F'}, back_rank};
+        constexpr Square g_square{File{'G'}, back_rank};
+        if (!has_piece(f_square) && !has_piece(g_square) && !is_attacked(king_square, opponent) && !is_attacked(f_square, opponent) && !is_attacked(g_square, opponent) &&
+            !detail::visit_move(visitor, castling_move(g_square))) {
+            return false;
+        }
+    }
+    if (state.castling_rights.has(detail::ColorTraits<C>::queenside_right)) {
+        constexpr Square d_square{File{'D'}, back_rank};
+        constexpr Square c_square{File{'C'}, back_rank};
+        constexpr Square b_square{File{'B'}, back_rank};
+        if (!has_piece(d_square) && !has_piece(c_square) && !has_piece(b_square) && !is_attacked(king_square, opponent) && !is_attacked(d_square, opponent) &&
+            !is_attacked(c_square, opponent) && !detail::visit_move(visitor, castling_move(c_square))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+template<GenerationMode Mode, typename Visitor>
+auto Bitboard::visit_if_legal(const Move &move, const PositionState &state, Visitor &visitor) const -> bool {
+    if constexpr (Mode == GenerationMode::Legal) {
+        if (!is_legal_move(move, state)) {
+            return true;
+        }
+    }
+    return detail::visit_move(visitor, move);
+}
+
+static_assert(sizeof(Bitboard) == 64);
+static_assert(std::is_trivially_copyable_v<Bitboard>);
+
 } // namespace chesscore
 
 #endif
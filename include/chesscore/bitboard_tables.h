@@ -13,458 +13,307 @@
 #include "chesscore/square.h"
 #include "chesscore/table.h"
 
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstdlib>
+
 namespace chesscore::bitmaps {
 
 using TargetTable = Table<Bitmap, 64, Square>;
+using RayTargetTable = Table<TargetTable, ray_direction_count, RayDirection>;
+using PawnTargetTable = Table<TargetTable, 2, Color>;
+using SquarePairTable = Table<TargetTable, 64, Square>;
+using DistanceTable = Table<Table<std::uint8_t, 64, Square>, 64, Square>;
+using RankTable = Table<Bitmap, 8, Rank>;
+using FileTable = Table<Bitmap, 8, File>;
 
-inline constexpr TargetTable knight_target_table{
-    Bitmap{0x0000000000020400ULL}, // A1
-    Bitmap{0x0000000000050800ULL}, // B1
-    Bitmap{0x00000000000A1100ULL}, // C1
-    Bitmap{0x0000000000142200ULL}, // D1
-    Bitmap{0x0000000000284400ULL}, // E1
-    Bitmap{0x0000000000508800ULL}, // F1
-    Bitmap{0x0000000000A01000ULL}, // G1
-    Bitmap{0x0000000000402000ULL}, // H1
-    Bitmap{0x0000000002040004ULL}, // A2
-    Bitmap{0x0000000005080008ULL}, // B2
-    Bitmap{0x000000000A110011ULL}, // C2
-    Bitmap{0x0000000014220022ULL}, // D2
-    Bitmap{0x0000000028440044ULL}, // E2
-    Bitmap{0x0000000050880088ULL}, // F2
-    Bitmap{0x00000000A0100010ULL}, // G2
-    Bitmap{0x0000000040200020ULL}, // H2
-    Bitmap{0x0000000204000402ULL}, // A3
-    Bitmap{0x0000000508000805ULL}, // B3
-    Bitmap{0x0000000A1100110AULL}, // C3
-    Bitmap{0x0000001422002214ULL}, // D3
-    Bitmap{0x0000002844004428ULL}, // E3
-    Bitmap{0x0000005088008850ULL}, // F3
-    Bitmap{0x000000A0100010A0ULL}, // G3
-    Bitmap{0x0000004020002040ULL}, // H3
-    Bitmap{0x0000020400040200ULL}, // A4
-    Bitmap{0x0000050800080500ULL}, // B4
-    Bitmap{0x00000A1100110A00ULL}, // C4
-    Bitmap{0x0000142200221400ULL}, // D4
-    Bitmap{0x0000284400442800ULL}, // E4
-    Bitmap{0x0000508800885000ULL}, // F4
-    Bitmap{0x0000A0100010A000ULL}, // G4
-    Bitmap{0x0000402000204000ULL}, // H4
-    Bitmap{0x0002040004020000ULL}, // A5
-    Bitmap{0x0005080008050000ULL}, // B5
-    Bitmap{0x000A1100110A0000ULL}, // C5
-    Bitmap{0x0014220022140000ULL}, // D5
-    Bitmap{0x0028440044280000ULL}, // E5
-    Bitmap{0x0050880088500000ULL}, // F5
-    Bitmap{0x00A0100010A00000ULL}, // G5
-    Bitmap{0x0040200020400000ULL}, // H5
-    Bitmap{0x0204000402000000ULL}, // A6
-    Bitmap{0x0508000805000000ULL}, // B6
-    Bitmap{0x0A1100110A000000ULL}, // C6
-    Bitmap{0x1422002214000000ULL}, // D6
-    Bitmap{0x2844004428000000ULL}, // E6
-    Bitmap{0x5088008850000000ULL}, // F6
-    Bitmap{0xA0100010A0000000ULL}, // G6
-    Bitmap{0x4020002040000000ULL}, // H6
-    Bitmap{0x0400040200000000ULL}, // A7
-    Bitmap{0x0800080500000000ULL}, // B7
-    Bitmap{0x1100110A00000000ULL}, // C7
-    Bitmap{0x2200221400000000ULL}, // D7
-    Bitmap{0x4400442800000000ULL}, // E7
-    Bitmap{0x8800885000000000ULL}, // F7
-    Bitmap{0x100010A000000000ULL}, // G7
-    Bitmap{0x2000204000000000ULL}, // H7
-    Bitmap{0x0004020000000000ULL}, // A8
-    Bitmap{0x0008050000000000ULL}, // B8
-    Bitmap{0x00110A0000000000ULL}, // C8
-    Bitmap{0x0022140000000000ULL}, // D8
-    Bitmap{0x0044280000000000ULL}, // E8
-    Bitmap{0x0088500000000000ULL}, // F8
-    Bitmap{0x0010A00000000000ULL}, // G8
-    Bitmap{0x0020400000000000ULL}, // H8
-};
+namespace detail {
 
-inline constexpr TargetTable bishop_target_table{
-    Bitmap{0x8040201008040200ULL}, // A1
-    Bitmap{0x0080402010080500ULL}, // B1
-    Bitmap{0x0000804020110A00ULL}, // C1
-    Bitmap{0x0000008041221400ULL}, // D1
-    Bitmap{0x0000000182442800ULL}, // E1
-    Bitmap{0x0000010204885000ULL}, // F1
-    Bitmap{0x000102040810A000ULL}, // G1
-    Bitmap{0x0102040810204000ULL}, // H1
-    Bitmap{0x4020100804020002ULL}, // A2
-    Bitmap{0x8040201008050005ULL}, // B2
-    Bitmap{0x00804020110A000AULL}, // C2
-    Bitmap{0x0000804122140014ULL}, // D2
-    Bitmap{0x0000018244280028ULL}, // E2
-    Bitmap{0x0001020488500050ULL}, // F2
-    Bitmap{0x0102040810A000A0ULL}, // G2
-    Bitmap{0x0204081020400040ULL}, // H2
-    Bitmap{0x2010080402000204ULL}, // A3
-    Bitmap{0x4020100805000508ULL}, // B3
-    Bitmap{0x804020110A000A11ULL}, // C3
-    Bitmap{0x0080412214001422ULL}, // D3
-    Bitmap{0x0001824428002844ULL}, // E3
-    Bitmap{0x0102048850005088ULL}, // F3
-    Bitmap{0x02040810A000A010ULL}, // G3
-    Bitmap{0x0408102040004020ULL}, // H3
-    Bitmap{0x1008040200020408ULL}, // A4
-    Bitmap{0x2010080500050810ULL}, // B4
-    Bitmap{0x4020110A000A1120ULL}, // C4
-    Bitmap{0x8041221400142241ULL}, // D4
-    Bitmap{0x0182442800284482ULL}, // E4
-    Bitmap{0x0204885000508804ULL}, // F4
-    Bitmap{0x040810A000A01008ULL}, // G4
-    Bitmap{0x0810204000402010ULL}, // H4
-    Bitmap{0x0804020002040810ULL}, // A5
-    Bitmap{0x1008050005081020ULL}, // B5
-    Bitmap{0x20110A000A112040ULL}, // C5
-    Bitmap{0x4122140014224180ULL}, // D5
-    Bitmap{0x8244280028448201ULL}, // E5
-    Bitmap{0x0488500050880402ULL}, // F5
-    Bitmap{0x0810A000A0100804ULL}, // G5
-    Bitmap{0x1020400040201008ULL}, // H5
-    Bitmap{0x0402000204081020ULL}, // A6
-    Bitmap{0x0805000508102040ULL}, // B6
-    Bitmap{0x110A000A11204080ULL}, // C6
-    Bitmap{0x2214001422418000ULL}, // D6
-    Bitmap{0x4428002844820100ULL}, // E6
-    Bitmap{0x8850005088040201ULL}, // F6
-    Bitmap{0x10A000A010080402ULL}, // G6
-    Bitmap{0x2040004020100804ULL}, // H6
-    Bitmap{0x0200020408102040ULL}, // A7
-    Bitmap{0x0500050810204080ULL}, // B7
-    Bitmap{0x0A000A1120408000ULL}, // C7
-    Bitmap{0x1400142241800000ULL}, // D7
-    Bitmap{0x2800284482010000ULL}, // E7
-    Bitmap{0x5000508804020100ULL}, // F7
-    Bitmap{0xA000A01008040201ULL}, // G7
-    Bitmap{0x4000402010080402ULL}, // H7
-    Bitmap{0x0002040810204080ULL}, // A8
-    Bitmap{0x0005081020408000ULL}, // B8
-    Bitmap{0x000A112040800000ULL}, // C8
-    Bitmap{0x0014224180000000ULL}, // D8
-    Bitmap{0x0028448201000000ULL}, // E8
-    Bitmap{0x0050880402010000ULL}, // F8
-    Bitmap{0x00A0100804020100ULL}, // G8
-    Bitmap{0x0040201008040201ULL}, // H8
+/**
+ * \brief A step on the board, given as file and rank offsets.
+ */
+struct Step {
+    int file; ///< Number of files to move (positive towards the h-file).
+    int rank; ///< Number of ranks to move (positive towards the 8th rank).
 };
 
-inline constexpr TargetTable rook_target_table{
-    Bitmap{0x01010101010101FEULL}, // A1
-    Bitmap{0x02020202020202FDULL}, // B1
-    Bitmap{0x04040404040404FBULL}, // C1
-    Bitmap{0x08080808080808F7ULL}, // D1
-    Bitmap{0x10101010101010EFULL}, // E1
-    Bitmap{0x20202020202020DFULL}, // F1
-    Bitmap{0x40404040404040BFULL}, // G1
-    Bitmap{0x808080808080807FULL}, // H1
-    Bitmap{0x010101010101FE01ULL}, // A2
-    Bitmap{0x020202020202FD02ULL}, // B2
-    Bitmap{0x040404040404FB04ULL}, // C2
-    Bitmap{0x080808080808F708ULL}, // D2
-    Bitmap{0x101010101010EF10ULL}, // E2
-    Bitmap{0x202020202020DF20ULL}, // F2
-    Bitmap{0x404040404040BF40ULL}, // G2
-    Bitmap{0x8080808080807F80ULL}, // H2
-    Bitmap{0x0101010101FE0101ULL}, // A3
-    Bitmap{0x0202020202FD0202ULL}, // B3
-    Bitmap{0x0404040404FB0404ULL}, // C3
-    Bitmap{0x0808080808F70808ULL}, // D3
-    Bitmap{0x1010101010EF1010ULL}, // E3
-    Bitmap{0x2020202020DF2020ULL}, // F3
-    Bitmap{0x4040404040BF4040ULL}, // G3
-    Bitmap{0x80808080807F8080ULL}, // H3
-    Bitmap{0x01010101FE010101ULL}, // A4
-    Bitmap{0x02020202FD020202ULL}, // B4
-    Bitmap{0x04040404FB040404ULL}, // C4
-    Bitmap{0x08080808F7080808ULL}, // D4
-    Bitmap{0x10101010EF101010ULL}, // E4
-    Bitmap{0x20202020DF202020ULL}, // F4
-    Bitmap{0x40404040BF404040ULL}, // G4
-    Bitmap{0x808080807F808080ULL}, // H4
-    Bitmap{0x010101FE01010101ULL}, // A5
-    Bitmap{0x020202FD02020202ULL}, // B5
-    Bitmap{0x040404FB04040404ULL}, // C5
-    Bitmap{0x080808F708080808ULL}, // D5
-    Bitmap{0x101010EF10101010ULL}, // E5
-    Bitmap{0x202020DF20202020ULL}, // F5
-    Bitmap{0x404040BF40404040ULL}, // G5
-    Bitmap{0x8080807F80808080ULL}, // H5
-    Bitmap{0x0101FE0101010101ULL}, // A6
-    Bitmap{0x0202FD0202020202ULL}, // B6
-    Bitmap{0x0404FB0404040404ULL}, // C6
-    Bitmap{0x0808F70808080808ULL}, // D6
-    Bitmap{0x1010EF1010101010ULL}, // E6
-    Bitmap{0x2020DF2020202020ULL}, // F6
-    Bitmap{0x4040BF4040404040ULL}, // G6
-    Bitmap{0x80807F8080808080ULL}, // H6
-    Bitmap{0x01FE010101010101ULL}, // A7
-    Bitmap{0x02FD020202020202ULL}, // B7
-    Bitmap{0x04FB040404040404ULL}, // C7
-    Bitmap{0x08F7080808080808ULL}, // D7
-    Bitmap{0x10EF101010101010ULL}, // E7
-    Bitmap{0x20DF202020202020ULL}, // F7
-    Bitmap{0x40BF404040404040ULL}, // G7
-    Bitmap{0x807F808080808080ULL}, // H7
-    Bitmap{0xFE01010101010101ULL}, // A8
-    Bitmap{0xFD02020202020202ULL}, // B8
-    Bitmap{0xFB04040404040404ULL}, // C8
-    Bitmap{0xF708080808080808ULL}, // D8
-    Bitmap{0xEF10101010101010ULL}, // E8
-    Bitmap{0xDF20202020202020ULL}, // F8
-    Bitmap{0xBF40404040404040ULL}, // G8
-    Bitmap{0x7F80808080808080ULL}, // H8
+/**
+ * \brief Single steps in the ray directions.
+ *
+ * Ordered like the RayDirection enumeration.
+ */
+inline constexpr std::array<Step, ray_direction_count> ray_steps{
+    Step{0, 1}, Step{1, 1}, Step{1, 0}, Step{1, -1}, Step{0, -1}, Step{-1, -1}, Step{-1, 0}, Step{-1, 1},
 };
 
-inline constexpr TargetTable queen_target_table{
-    Bitmap{0x81412111090503FEULL}, // A1
-    Bitmap{0x02824222120A07FDULL}, // B1
-    Bitmap{0x0404844424150EFBULL}, // C1
-    Bitmap{0x08080888492A1CF7ULL}, // D1
-    Bitmap{0x10101011925438EFULL}, // E1
-    Bitmap{0x2020212224A870DFULL}, // F1
-    Bitmap{0x404142444850E0BFULL}, // G1
-    Bitmap{0x8182848890A0C07FULL}, // H1
-    Bitmap{0x412111090503FE03ULL}, // A2
-    Bitmap{0x824222120A07FD07ULL}, // B2
-    Bitmap{0x04844424150EFB0EULL}, // C2
-    Bitmap{0x080888492A1CF71CULL}, // D2
-    Bitmap{0x101011925438EF38ULL}, // E2
-    Bitmap{0x20212224A870DF70ULL}, // F2
-    Bitmap{0x4142444850E0BFE0ULL}, // G2
-    Bitmap{0x82848890A0C07FC0ULL}, // H2
-    Bitmap{0x2111090503FE0305ULL}, // A3
-    Bitmap{0x4222120A07FD070AULL}, // B3
-    Bitmap{0x844424150EFB0E15ULL}, // C3
-    Bitmap{0x0888492A1CF71C2AULL}, // D3
-    Bitmap{0x1011925438EF3854ULL}, // E3
-    Bitmap{0x212224A870DF70A8ULL}, // F3
-    Bitmap{0x42444850E0BFE050ULL}, // G3
-    Bitmap{0x848890A0C07FC0A0ULL}, // H3
-    Bitmap{0x11090503FE030509ULL}, // A4
-    Bitmap{0x22120A07FD070A12ULL}, // B4
-    Bitmap{0x4424150EFB0E1524ULL}, // C4
-    Bitmap{0x88492A1CF71C2A49ULL}, // D4
-    Bitmap{0x11925438EF385492ULL}, // E4
-    Bitmap{0x2224A870DF70A824ULL}, // F4
-    Bitmap{0x444850E0BFE05048ULL}, // G4
-    Bitmap{0x8890A0C07FC0A090ULL}, // H4
-    Bitmap{0x090503FE03050911ULL}, // A5
-    Bitmap{0x120A07FD070A1222ULL}, // B5
-    Bitmap{0x24150EFB0E152444ULL}, // C5
-    Bitmap{0x492A1CF71C2A4988ULL}, // D5
-    Bitmap{0x925438EF38549211ULL}, // E5
-    Bitmap{0x24A870DF70A82422ULL}, // F5
-    Bitmap{0x4850E0BFE0504844ULL}, // G5
-    Bitmap{0x90A0C07FC0A09088ULL}, // H5
-    Bitmap{0x0503FE0305091121ULL}, // A6
-    Bitmap{0x0A07FD070A122242ULL}, // B6
-    Bitmap{0x150EFB0E15244484ULL}, // C6
-    Bitmap{0x2A1CF71C2A498808ULL}, // D6
-    Bitmap{0x5438EF3854921110ULL}, // E6
-    Bitmap{0xA870DF70A8242221ULL}, // F6
-    Bitmap{0x50E0BFE050484442ULL}, // G6
-    Bitmap{0xA0C07FC0A0908884ULL}, // H6
-    Bitmap{0x03FE030509112141ULL}, // A7
-    Bitmap{0x07FD070A12224282ULL}, // B7
-    Bitmap{0x0EFB0E1524448404ULL}, // C7
-    Bitmap{0x1CF71C2A49880808ULL}, // D7
-    Bitmap{0x38EF385492111010ULL}, // E7
-    Bitmap{0x70DF70A824222120ULL}, // F7
-    Bitmap{0xE0BFE05048444241ULL}, // G7
-    Bitmap{0xC07FC0A090888482ULL}, // H7
-    Bitmap{0xFE03050911214181ULL}, // A8
-    Bitmap{0xFD070A1222428202ULL}, // B8
-    Bitmap{0xFB0E152444840404ULL}, // C8
-    Bitmap{0xF71C2A4988080808ULL}, // D8
-    Bitmap{0xEF38549211101010ULL}, // E8
-    Bitmap{0xDF70A82422212020ULL}, // F8
-    Bitmap{0xBFE0504844424140ULL}, // G8
-    Bitmap{0x7FC0A09088848281ULL}, // H8
-};
+/**
+ * \brief Capture steps of a white pawn.
+ */
+inline constexpr std::array<Step, 2> white_pawn_capture_steps{Step{-1, 1}, Step{1, 1}};
+
+/**
+ * \brief Capture steps of a black pawn.
+ */
+inline constexpr std::array<Step, 2> black_pawn_capture_steps{Step{-1, -1}, Step{1, -1}};
 
-inline constexpr TargetTable king_target_table{
-    Bitmap{0x0000000000000302ULL}, // A1
-    Bitmap{0x0000000000000705ULL}, // B1
-    Bitmap{0x0000000000000E0AULL}, // C1
-    Bitmap{0x0000000000001C14ULL}, // D1
-    Bitmap{0x0000000000003828ULL}, // E1
-    Bitmap{0x0000000000007050ULL}, // F1
-    Bitmap{0x000000000000E0A0ULL}, // G1
-    Bitmap{0x000000000000C040ULL}, // H1
-    Bitmap{0x0000000000030203ULL}, // A2
-    Bitmap{0x0000000000070507ULL}, // B2
-    Bitmap{0x00000000000E0A0EULL}, // C2
-    Bitmap{0x00000000001C141CULL}, // D2
-    Bitmap{0x0000000000382838ULL}, // E2
-    Bitmap{0x0000000000705070ULL}, // F2
-    Bitmap{0x0000000000E0A0E0ULL}, // G2
-    Bitmap{0x0000000000C040C0ULL}, // H2
-    Bitmap{0x0000000003020300ULL}, // A3
-    Bitmap{0x0000000007050700ULL}, // B3
-    Bitmap{0x000000000E0A0E00ULL}, // C3
-    Bitmap{0x000000001C141C00ULL}, // D3
-    Bitmap{0x0000000038283800ULL}, // E3
-    Bitmap{0x0000000070507000ULL}, // F3
-    Bitmap{0x00000000E0A0E000ULL}, // G3
-    Bitmap{0x00000000C040C000ULL}, // H3
-    Bitmap{0x0000000302030000ULL}, // A4
-    Bitmap{0x0000000705070000ULL}, // B4
-    Bitmap{0x0000000E0A0E0000ULL}, // C4
-    Bitmap{0x0000001C141C0000ULL}, // D4
-    Bitmap{0x0000003828380000ULL}, // E4
-    Bitmap{0x0000007050700000ULL}, // F4
-    Bitmap{0x000000E0A0E00000ULL}, // G4
-    Bitmap{0x000000C040C00000ULL}, // H4
-    Bitmap{0x0000030203000000ULL}, // A5
-    Bitmap{0x0000070507000000ULL}, // B5
-    Bitmap{0x00000E0A0E000000ULL}, // C5
-    Bitmap{0x00001C141C000000ULL}, // D5
-    Bitmap{0x0000382838000000ULL}, // E5
-    Bitmap{0x0000705070000000ULL}, // F5
-    Bitmap{0x0000E0A0E0000000ULL}, // G5
-    Bitmap{0x0000C040C0000000ULL}, // H5
-    Bitmap{0x0003020300000000ULL}, // A6
-    Bitmap{0x0007050700000000ULL}, // B6
-    Bitmap{0x000E0A0E00000000ULL}, // C6
-    Bitmap{0x001C141C00000000ULL}, // D6
-    Bitmap{0x0038283800000000ULL}, // E6
-    Bitmap{0x0070507000000000ULL}, // F6
-    Bitmap{0x00E0A0E000000000ULL}, // G6
-    Bitmap{0x00C040C000000000ULL}, // H6
-    Bitmap{0x0302030000000000ULL}, // A7
-    Bitmap{0x0705070000000000ULL}, // B7
-    Bitmap{0x0E0A0E0000000000ULL}, // C7
-    Bitmap{0x1C141C0000000000ULL}, // D7
-    Bitmap{0x3828380000000000ULL}, // E7
-    Bitmap{0x7050700000000000ULL}, // F7
-    Bitmap{0xE0A0E00000000000ULL}, // G7
-    Bitmap{0xC040C00000000000ULL}, // H7
-    Bitmap{0x0203000000000000ULL}, // A8
-    Bitmap{0x0507000000000000ULL}, // B8
-    Bitmap{0x0A0E000000000000ULL}, // C8
-    Bitmap{0x141C000000000000ULL}, // D8
-    Bitmap{0x2838000000000000ULL}, // E8
-    Bitmap{0x5070000000000000ULL}, // F8
-    Bitmap{0xA0E0000000000000ULL}, // G8
-    Bitmap{0x40C0000000000000ULL}, // H8
+/**
+ * \brief Steps of a knight.
+ */
+inline constexpr std::array<Step, 8> knight_steps{
+    Step{1, 2}, Step{2, 1}, Step{2, -1}, Step{1, -2}, Step{-1, -2}, Step{-2, -1}, Step{-2, 1}, Step{-1, 2},
 };
 
-extern const TargetTable north_ray_target_table;
-extern const TargetTable northeast_ray_target_table;
-extern const TargetTable east_ray_target_table;
-extern const TargetTable southeast_ray_target_table;
-extern const TargetTable south_ray_target_table;
-extern const TargetTable southwest_ray_target_table;
-extern const TargetTable west_ray_target_table;
-extern const TargetTable northwest_ray_target_table;
+/**
+ * \brief Check, if zero-based file and rank coordinates are on the board.
+ *
+ * \param file The zero-based file.
+ * \param rank The zero-based rank.
+ * \return If the coordinates denote a square on the board.
+ */
+constexpr auto on_board(int file, int rank) -> bool {
+    return file >= 0 && file < File::max_file && rank >= 0 && rank < Rank::max_rank;
+}
+
+/**
+ * \brief Bit mask for the square with zero-based file and rank coordinates.
+ *
+ * \param file The zero-based file.
+ * \param rank The zero-based rank.
+ * \return The bit mask with only the bit for the square set.
+ */
+constexpr auto square_bit(int file, int rank) -> std::uint64_t {
+    return 1ULL << (rank * File::max_file + file);
+}
+
+/**
+ * \brief Generate the targets of a piece that makes single steps.
+ *
+ * \param steps The steps the piece can make.
+ * \return For every square the squares reachable in one step.
+ */
+template<std::size_t N>
+constexpr auto generate_step_table(const std::array<Step, N> &steps) -> TargetTable {
+    std::array<Bitmap, Square::count> targets{};
+    for (int index = 0; index < Square::count; ++index) {
+        const int file = index % File::max_file;
+        const int rank = index / File::max_file;
+        std::uint64_t bits{0ULL};
+        for (const auto &step : steps) {
+            if (on_board(file + step.file, rank + step.rank)) {
+                bits |= square_bit(file + step.file, rank + step.rank);
+            }
+        }
+        targets[static_cast<std::size_t>(index)] = Bitmap{bits};
+    }
+    return TargetTable{targets};
+}
+
+/**
+ * \brief Generate the squares on a ray, starting next to each square.
+ *
+ * \param step The step in the direction of the ray.
+ * \return For every square the squares on the ray, up to the edge of the board.
+ */
+constexpr auto generate_ray_table(const Step &step) -> TargetTable {
+    std::array<Bitmap, Square::count> targets{};
+    for (int index = 0; index < Square::count; ++index) {
+        std::uint64_t bits{0ULL};
+        for (int file = index % File::max_file + step.file, rank = index / File::max_file + step.rank; on_board(file, rank); file += step.file, rank += step.rank) {
+            bits |= square_bit(file, rank);
+        }
+        targets[static_cast<std::size_t>(index)] = Bitmap{bits};
+    }
+    return TargetTable{targets};
+}
+
+/**
+ * \brief Generate the targets of a sliding piece on an empty board.
+ *
+ * \param first_direction Index of the first direction the piece moves in.
+ * \return The union of every second ray, starting at the given direction.
+ */
+constexpr auto generate_slider_table(std::size_t first_direction) -> TargetTable {
+    std::array<Bitmap, Square::count> targets{};
+    for (std::size_t direction = first_direction; direction < ray_direction_count; direction += 2) {
+        const auto rays = generate_ray_table(ray_steps[direction]);
+        for (std::size_t index = 0; index < targets.size(); ++index) {
+            targets[index] |= rays[Square::from_index(index)];
+        }
+    }
+    return TargetTable{targets};
+}
+
+/**
+ * \brief Generate the table of squares between two squares.
+ *
+ * For squares on a common rank, file or diagonal, the entry contains the
+ * squares strictly between them. All other entries are empty.
+ * \return The table of squares between two squares.
+ */
+constexpr auto generate_between_table() -> SquarePairTable {
+    std::array<std::array<Bitmap, Square::count>, Square::count> between{};
+    for (int index = 0; index < Square::count; ++index) {
+        for (const auto &step : ray_steps) {
+            std::uint64_t bits{0ULL};
+            for (int file = index % File::max_file + step.file, rank = index / File::max_file + step.rank; on_board(file, rank); file += step.file, rank += step.rank) {
+                between[static_cast<std::size_t>(index)][static_cast<std::size_t>(rank * File::max_file + file)] = Bitmap{bits};
+                bits |= square_bit(file, rank);
+            }
+        }
+    }
+    std::array<TargetTable, Square::count> table{};
+    std::ranges::transform(between, table.begin(), [](const auto &row) { return TargetTable{row}; });
+    return SquarePairTable{table};
+}
+
+/**
+ * \brief Generate the table of full lines through two squares.
+ *
+ * For squares on a common rank, file or diagonal, the entry contains the whole
+ * line through both squares, from edge to edge. All other entries are empty.
+ * \return The table of lines through two squares.
+ */
+constexpr auto generate_line_table() -> SquarePairTable {
+    std::array<std::array<Bitmap, Square::count>, Square::count> lines{};
+    for (int index = 0; index < Square::count; ++index) {
+        const int from_file = index % File::max_file;
+        const int from_rank = index / File::max_file;
+        for (const auto &step : ray_steps) {
+            std::uint64_t line{square_bit(from_file, from_rank)};
+            for (int sign : {1, -1}) {
+                for (int file = from_file + sign * step.file, rank = from_rank + sign * step.rank; on_board(file, rank); file += sign * step.file, rank += sign * step.rank) {
+                    line |= square_bit(file, rank);
+                }
+            }
+            for (int file = from_file + step.file, rank = from_rank + step.rank; on_board(file, rank); file += step.file, rank += step.rank) {
+                lines[static_cast<std::size_t>(index)][static_cast<std::size_t>(rank * File::max_file + file)] = Bitmap{line};
+            }
+        }
+    }
+    std::array<TargetTable, Square::count> table{};
+    std::ranges::transform(lines, table.begin(), [](const auto &row) { return TargetTable{row}; });
+    return SquarePairTable{table};
+}
 
+/**
+ * \brief Generate the table of Chebyshev distances between two squares.
+ *
+ * \return The table of distances.
+ */
+constexpr auto generate_distance_table() -> DistanceTable {
+    std::array<Table<std::uint8_t, Square::count, Square>, Square::count> table{};
+    for (int from = 0; from < Square::count; ++from) {
+        std::array<std::uint8_t, Square::count> distances{};
+        for (int to = 0; to < Square::count; ++to) {
+            const int file_distance = std::abs(from % File::max_file - to % File::max_file);
+            const int rank_distance = std::abs(from / File::max_file - to / File::max_file);
+            distances[static_cast<std::size_t>(to)] = static_cast<std::uint8_t>(std::max(file_distance, rank_distance));
+        }
+        table[static_cast<std::size_t>(from)] = Table<std::uint8_t, Square::count, Square>{distances};
+    }
+    return DistanceTable{table};
+}
+
+/**
+ * \brief Generate the table of ranks.
+ *
+ * \return The squares on each rank.
+ */
+constexpr auto generate_rank_table() -> RankTable {
+    std::array<Bitmap, Rank::max_rank> ranks{};
+    for (std::size_t rank = 0; rank < ranks.size(); ++rank) {
+        ranks[rank] = Bitmap{0xFFULL << (rank * File::max_file)};
+    }
+    return RankTable{ranks};
+}
+
+/**
+ * \brief Generate the table of files.
+ *
+ * \return The squares on each file.
+ */
+constexpr auto generate_file_table() -> FileTable {
+    std::array<Bitmap, File::max_file> files{};
+    for (std::size_t file = 0; file < files.size(); ++file) {
+        files[file] = Bitmap{0x0101010101010101ULL << file};
+    }
+    return FileTable{files};
+}
+
+} // namespace detail
+
+inline constexpr TargetTable knight_target_table{detail::generate_step_table(detail::knight_steps)};
+inline constexpr TargetTable king_target_table{detail::generate_step_table(detail::ray_steps)};
+inline constexpr PawnTargetTable pawn_attack_table{detail::generate_step_table(detail::white_pawn_capture_steps), detail::generate_step_table(detail::black_pawn_capture_steps)};
+inline constexpr TargetTable rook_target_table{detail::generate_slider_table(0)};
+inline constexpr TargetTable bishop_target_table{detail::generate_slider_table(1)};
+inline constexpr TargetTable queen_target_table{[] {
+    std::array<Bitmap, Square::count> targets{};
+    for (std::size_t index = 0; index < targets.size(); ++index) {
+        targets[index] = rook_target_table[Square::from_index(index)] | bishop_target_table[Square::from_index(index)];
+    }
+    return TargetTable{targets};
+}()};
+
+/**
+ * \brief Get the target table for a piece type.
+ *
+ * Pawns have no target table, since their moves depend on their color.
+ * \param piece_type The piece type.
+ * \return The target table for the piece type.
+ */
 inline auto get_target_table(const PieceType &piece_type) -> const TargetTable & {
-    std::array<const TargetTable *, piece_type_count - 1> target_tables{&rook_target_table, &knight_target_table, &bishop_target_table, &queen_target_table, &king_target_table};
+    static constexpr std::array<const TargetTable *, 5> target_tables{&rook_target_table, &knight_target_table, &bishop_target_table, &queen_target_table, &king_target_table};
     return *target_tables.at(get_index(piece_type) - 1);
 }
 
-using RayTargetTable = Table<TargetTable, ray_direction_count, RayDirection>;
-
-// clang-format off
 inline constexpr RayTargetTable ray_target_table{
-    TargetTable{ // north
- Bitmap{0x0101010101010100ULL},Bitmap{0x0202020202020200ULL},Bitmap{0x0404040404040400ULL},Bitmap{0x0808080808080800ULL},Bitmap{0x1010101010101000ULL},Bitmap{0x2020202020202000ULL},Bitmap{0x4040404040404000ULL},Bitmap{0x8080808080808000ULL}, 
- Bitmap{0x0101010101010000ULL},Bitmap{0x0202020202020000ULL},Bitmap{0x0404040404040000ULL},Bitmap{0x0808080808080000ULL},Bitmap{0x1010101010100000ULL},Bitmap{0x2020202020200000ULL},Bitmap{0x4040404040400000ULL},Bitmap{0x8080808080800000ULL}, 
- Bitmap{0x0101010101000000ULL},Bitmap{0x0202020202000000ULL},Bitmap{0x0404040404000000ULL},Bitmap{0x0808080808000000ULL},Bitmap{0x1010101010000000ULL},Bitmap{0x2020202020000000ULL},Bitmap{0x4040404040000000ULL},Bitmap{0x8080808080000000ULL},
- Bitmap{0x0101010100000000ULL},Bitmap{0x0202020200000000ULL},Bitmap{0x0404040400000000ULL},Bitmap{0x0808080800000000ULL},Bitmap{0x1010101000000000ULL},Bitmap{0x2020202000000000ULL},Bitmap{0x4040404000000000ULL},Bitmap{0x8080808000000000ULL},
- Bitmap{0x0101010000000000ULL},Bitmap{0x0202020000000000ULL},Bitmap{0x0404040000000000ULL},Bitmap{0x0808080000000000ULL},Bitmap{0x1010100000000000ULL},Bitmap{0x2020200000000000ULL},Bitmap{0x4040400000000000ULL},Bitmap{0x8080800000000000ULL},
- Bitmap{0x0101000000000000ULL},Bitmap{0x0202000000000000ULL},Bitmap{0x0404000000000000ULL},Bitmap{0x0808000000000000ULL},Bitmap{0x1010000000000000ULL},Bitmap{0x2020000000000000ULL},Bitmap{0x4040000000000000ULL},Bitmap{0x8080000000000000ULL},
- Bitmap{0x0100000000000000ULL},Bitmap{0x0200000000000000ULL},Bitmap{0x0400000000000000ULL},Bitmap{0x0800000000000000ULL},Bitmap{0x1000000000000000ULL},Bitmap{0x2000000000000000ULL},Bitmap{0x4000000000000000ULL},Bitmap{0x8000000000000000ULL},
- Bitmap{0x0000000000000000ULL},Bitmap{0x0000000000000000ULL},Bitmap{0x0000000000000000ULL},Bitmap{0x0000000000000000ULL},Bitmap{0x0000000000000000ULL},Bitmap{0x0000000000000000ULL},Bitmap{0x0000000000000000ULL},Bitmap{0x0000000000000000ULL},
- },
-    TargetTable{ // north east
- Bitmap{0x8040201008040200ULL},Bitmap{0x0080402010080400ULL},Bitmap{0x0000804020100800ULL},Bitmap{0x0000008040201000ULL},Bitmap{0x0000000080402000ULL},Bitmap{0x0000000000804000ULL},Bitmap{0x0000000000008000ULL},Bitmap{0x0000000000000000ULL},
- Bitmap{0x4020100804020000ULL},Bitmap{0x8040201008040000ULL},Bitmap{0x0080402010080000ULL},Bitmap{0x0000804020100000ULL},Bitmap{0x0000008040200000ULL},Bitmap{0x0000000080400000ULL},Bitmap{0x0000000000800000ULL},Bitmap{0x0000000000000000ULL},
- Bitmap{0x2010080402000000ULL},Bitmap{0x4020100804000000ULL},Bitmap{0x8040201008000000ULL},Bitmap{0x0080402010000000ULL},Bitmap{0x0000804020000000ULL},Bitmap{0x0000008040000000ULL},Bitmap{0x0000000080000000ULL},Bitmap{0x0000000000000000ULL},
- Bitmap{0x1008040200000000ULL},Bitmap{0x2010080400000000ULL},Bitmap{0x4020100800000000ULL},Bitmap{0x8040201000000000ULL},Bitmap{0x0080402000000000ULL},Bitmap{0x0000804000000000ULL},Bitmap{0x0000008000000000ULL},Bitmap{0x0000000000000000ULL},
- Bitmap{0x0804020000000000ULL},Bitmap{0x1008040000000000ULL},Bitmap{0x2010080000000000ULL},Bitmap{0x4020100000000000ULL},Bitmap{0x8040200000000000ULL},Bitmap{0x0080400000000000ULL},Bitmap{0x0000800000000000ULL},Bitmap{0x0000000000000000ULL},
- Bitmap{0x0402000000000000ULL},Bitmap{0x0804000000000000ULL},Bitmap{0x1008000000000000ULL},Bitmap{0x2010000000000000ULL},Bitmap{0x4020000000000000ULL},Bitmap{0x8040000000000000ULL},Bitmap{0x0080000000000000ULL},Bitmap{0x0000000000000000ULL},
- Bitmap{0x0200000000000000ULL},Bitmap{0x0400000000000000ULL},Bitmap{0x0800000000000000ULL},Bitmap{0x1000000000000000ULL},Bitmap{0x2000000000000000ULL},Bitmap{0x4000000000000000ULL},Bitmap{0x8000000000000000ULL},Bitmap{0x0000000000000000ULL},
- Bitmap{0x0000000000000000ULL},Bitmap{0x0000000000000000ULL},Bitmap{0x0000000000000000ULL},Bitmap{0x0000000000000000ULL},Bitmap{0x0000000000000000ULL},Bitmap{0x0000000000000000ULL},Bitmap{0x0000000000000000ULL},Bitmap{0x0000000000000000ULL},
- },
-    TargetTable{ // east
- Bitmap{0x00000000000000FEULL},Bitmap{0x00000000000000FCULL},Bitmap{0x00000000000000F8ULL},Bitmap{0x00000000000000F0ULL},Bitmap{0x00000000000000E0ULL},Bitmap{0x00000000000000C0ULL},Bitmap{0x0000000000000080ULL},Bitmap{0x0000000000000000ULL},
- Bitmap{0x000000000000FE00ULL},Bitmap{0x000000000000FC00ULL},Bitmap{0x000000000000F800ULL},Bitmap{0x000000000000F000ULL},Bitmap{0x000000000000E000ULL},Bitmap{0x000000000000C000ULL},Bitmap{0x0000000000008000ULL},Bitmap{0x0000000000000000ULL},
- Bitmap{0x0000000000FE0000ULL},Bitmap{0x0000000000FC0000ULL},Bitmap{0x0000000000F80000ULL},Bitmap{0x0000000000F00000ULL},Bitmap{0x0000000000E00000ULL},Bitmap{0x0000000000C00000ULL},Bitmap{0x0000000000800000ULL},Bitmap{0x0000000000000000ULL},
- Bitmap{0x00000000FE000000ULL},Bitmap{0x00000000FC000000ULL},Bitmap{0x00000000F8000000ULL},Bitmap{0x00000000F0000000ULL},Bitmap{0x00000000E0000000ULL},Bitmap{0x00000000C0000000ULL},Bitmap{0x0000000080000000ULL},Bitmap{0x0000000000000000ULL},
- Bitmap{0x000000FE00000000ULL},Bitmap{0x000000FC00000000ULL},Bitmap{0x000000F800000000ULL},Bitmap{0x000000F000000000ULL},Bitmap{0x000000E000000000ULL},Bitmap{0x000000C000000000ULL},Bitmap{0x0000008000000000ULL},Bitmap{0x0000000000000000ULL},
- Bitmap{0x0000FE0000000000ULL},Bitmap{0x0000FC0000000000ULL},Bitmap{0x0000F80000000000ULL},Bitmap{0x0000F00000000000ULL},Bitmap{0x0000E00000000000ULL},Bitmap{0x0000C00000000000ULL},Bitmap{0x0000800000000000ULL},Bitmap{0x0000000000000000ULL},
- Bitmap{0x00FE000000000000ULL},Bitmap{0x00FC000000000000ULL},Bitmap{0x00F8000000000000ULL},Bitmap{0x00F0000000000000ULL},Bitmap{0x00E0000000000000ULL},Bitmap{0x00C0000000000000ULL},Bitmap{0x0080000000000000ULL},Bitmap{0x0000000000000000ULL},
- Bitmap{0xFE00000000000000ULL},Bitmap{0xFC00000000000000ULL},Bitmap{0xF800000000000000ULL},Bitmap{0xF000000000000000ULL},Bitmap{0xE000000000000000ULL},Bitmap{0xC000000000000000ULL},Bitmap{0x8000000000000000ULL},Bitmap{0x0000000000000000ULL},
- },
-    TargetTable{ // south east
- Bitmap{0x0000000000000000ULL},Bitmap{0x0000000000000000ULL},Bitmap{0x0000000000000000ULL},Bitmap{0x0000000000000000ULL},Bitmap{0x0000000000000000ULL},Bitmap{0x0000000000000000ULL},Bitmap{0x0000000000000000ULL},Bitmap{0x0000000000000000ULL},
- Bitmap{0x0000000000000002ULL},Bitmap{0x0000000000000004ULL},Bitmap{0x0000000000000008ULL},Bitmap{0x0000000000000010ULL},Bitmap{0x0000000000000020ULL},Bitmap{0x0000000000000040ULL},Bitmap{0x0000000000000080ULL},Bitmap{0x0000000000000000ULL},
- Bitmap{0x0000000000000204ULL},Bitmap{0x0000000000000408ULL},Bitmap{0x0000000000000810ULL},Bitmap{0x0000000000001020ULL},Bitmap{0x0000000000002040ULL},Bitmap{0x0000000000004080ULL},Bitmap{0x0000000000008000ULL},Bitmap{0x0000000000000000ULL},
- Bitmap{0x0000000000020408ULL},Bitmap{0x0000000000040810ULL},Bitmap{0x0000000000081020ULL},Bitmap{0x0000000000102040ULL},Bitmap{0x0000000000204080ULL},Bitmap{0x0000000000408000ULL},Bitmap{0x0000000000800000ULL},Bitmap{0x0000000000000000ULL},
- Bitmap{0x0000000002040810ULL},Bitmap{0x0000000004081020ULL},Bitmap{0x0000000008102040ULL},Bitmap{0x0000000010204080ULL},Bitmap{0x0000000020408000ULL},Bitmap{0x0000000040800000ULL},Bitmap{0x0000000080000000ULL},Bitmap{0x0000000000000000ULL},
- Bitmap{0x0000000204081020ULL},Bitmap{0x0000000408102040ULL},Bitmap{0x0000000810204080ULL},Bitmap{0x0000001020408000ULL},Bitmap{0x0000002040800000ULL},Bitmap{0x0000004080000000ULL},Bitmap{0x0000008000000000ULL},Bitmap{0x0000000000000000ULL},
- Bitmap{0x0000020408102040ULL},Bitmap{0x0000040810204080ULL},Bitmap{0x0000081020408000ULL},Bitmap{0x0000102040800000ULL},Bitmap{0x0000204080000000ULL},Bitmap{0x0000408000000000ULL},Bitmap{0x0000800000000000ULL},Bitmap{0x0000000000000000ULL},
- Bitmap{0x0002040810204080ULL},Bitmap{0x0004081020408000ULL},Bitmap{0x0008102040800000ULL},Bitmap{0x0010204080000000ULL},Bitmap{0x0020408000000000ULL},Bitmap{0x0040800000000000ULL},Bitmap{0x0080000000000000ULL},Bitmap{0x0000000000000000ULL},
- },
-    TargetTable{ // south
- Bitmap{0x0000000000000000ULL},Bitmap{0x0000000000000000ULL},Bitmap{0x0000000000000000ULL},Bitmap{0x0000000000000000ULL},Bitmap{0x0000000000000000ULL},Bitmap{0x0000000000000000ULL},Bitmap{0x0000000000000000ULL},Bitmap{0x0000000000000000ULL},
- Bitmap{0x0000000000000001ULL},Bitmap{0x0000000000000002ULL},Bitmap{0x0000000000000004ULL},Bitmap{0x0000000000000008ULL},Bitmap{0x0000000000000010ULL},Bitmap{0x0000000000000020ULL},Bitmap{0x0000000000000040ULL},Bitmap{0x0000000000000080ULL},
- Bitmap{0x0000000000000101ULL},Bitmap{0x0000000000000202ULL},Bitmap{0x0000000000000404ULL},Bitmap{0x0000000000000808ULL},Bitmap{0x0000000000001010ULL},Bitmap{0x0000000000002020ULL},Bitmap{0x0000000000004040ULL},Bitmap{0x0000000000008080ULL},
- Bitmap{0x0000000000010101ULL},Bitmap{0x0000000000020202ULL},Bitmap{0x0000000000040404ULL},Bitmap{0x0000000000080808ULL},Bitmap{0x0000000000101010ULL},Bitmap{0x0000000000202020ULL},Bitmap{0x0000000000404040ULL},Bitmap{0x0000000000808080ULL},
- Bitmap{0x0000000001010101ULL},Bitmap{0x0000000002020202ULL},Bitmap{0x0000000004040404ULL},Bitmap{0x0000000008080808ULL},Bitmap{0x0000000010101010ULL},Bitmap{0x0000000020202020ULL},Bitmap{0x0000000040404040ULL},Bitmap{0x0000000080808080ULL},
- Bitmap{0x0000000101010101ULL},Bitmap{0x0000000202020202ULL},Bitmap{0x0000000404040404ULL},Bitmap{0x0000000808080808ULL},Bitmap{0x0000001010101010ULL},Bitmap{0x0000002020202020ULL},Bitmap{0x0000004040404040ULL},Bitmap{0x0000008080808080ULL},
- Bitmap{0x0000010101010101ULL},Bitmap{0x0000020202020202ULL},Bitmap{0x0000040404040404ULL},Bitmap{0x0000080808080808ULL},Bitmap{0x0000101010101010ULL},Bitmap{0x0000202020202020ULL},Bitmap{0x0000404040404040ULL},Bitmap{0x0000808080808080ULL},
- Bitmap{0x0001010101010101ULL},Bitmap{0x0002020202020202ULL},Bitmap{0x0004040404040404ULL},Bitmap{0x0008080808080808ULL},Bitmap{0x0010101010101010ULL},Bitmap{0x0020202020202020ULL},Bitmap{0x0040404040404040ULL},Bitmap{0x0080808080808080ULL},
- },
-    TargetTable{ // south west
- Bitmap{0x0000000000000000ULL},Bitmap{0x0000000000000000ULL},Bitmap{0x0000000000000000ULL},Bitmap{0x0000000000000000ULL},Bitmap{0x0000000000000000ULL},Bitmap{0x0000000000000000ULL},Bitmap{0x0000000000000000ULL},Bitmap{0x0000000000000000ULL},
- Bitmap{0x0000000000000000ULL},Bitmap{0x0000000000000001ULL},Bitmap{0x0000000000000002ULL},Bitmap{0x0000000000000004ULL},Bitmap{0x0000000000000008ULL},Bitmap{0x0000000000000010ULL},Bitmap{0x0000000000000020ULL},Bitmap{0x0000000000000040ULL},
- Bitmap{0x0000000000000000ULL},Bitmap{0x0000000000000100ULL},Bitmap{0x0000000000000201ULL},Bitmap{0x0000000000000402ULL},Bitmap{0x0000000000000804ULL},Bitmap{0x0000000000001008ULL},Bitmap{0x0000000000002010ULL},Bitmap{0x0000000000004020ULL},
- Bitmap{0x0000000000000000ULL},Bitmap{0x0000000000010000ULL},Bitmap{0x0000000000020100ULL},Bitmap{0x0000000000040201ULL},Bitmap{0x0000000000080402ULL},Bitmap{0x0000000000100804ULL},Bitmap{0x0000000000201008ULL},Bitmap{0x0000000000402010ULL},
- Bitmap{0x0000000000000000ULL},Bitmap{0x0000000001000000ULL},Bitmap{0x0000000002010000ULL},Bitmap{0x0000000004020100ULL},Bitmap{0x0000000008040201ULL},Bitmap{0x0000000010080402ULL},Bitmap{0x0000000020100804ULL},Bitmap{0x0000000040201008ULL},
- Bitmap{0x0000000000000000ULL},Bitmap{0x0000000100000000ULL},Bitmap{0x0000000201000000ULL},Bitmap{0x0000000402010000ULL},Bitmap{0x0000000804020100ULL},Bitmap{0x0000001008040201ULL},Bitmap{0x0000002010080402ULL},Bitmap{0x0000004020100804ULL},
- Bitmap{0x0000000000000000ULL},Bitmap{0x0000010000000000ULL},Bitmap{0x0000020100000000ULL},Bitmap{0x0000040201000000ULL},Bitmap{0x0000080402010000ULL},Bitmap{0x0000100804020100ULL},Bitmap{0x0000201008040201ULL},Bitmap{0x0000402010080402ULL},
- Bitmap{0x0000000000000000ULL},Bitmap{0x0001000000000000ULL},Bitmap{0x0002010000000000ULL},Bitmap{0x0004020100000000ULL},Bitmap{0x0008040201000000ULL},Bitmap{0x0010080402010000ULL},Bitmap{0x0020100804020100ULL},Bitmap{0x0040201008040201ULL},
- },
-    TargetTable{ // west
- Bitmap{0x0000000000000000ULL},Bitmap{0x0000000000000001ULL},Bitmap{0x0000000000000003ULL},Bitmap{0x0000000000000007ULL},Bitmap{0x000000000000000FULL},Bitmap{0x000000000000001FULL},Bitmap{0x000000000000003FULL},Bitmap{0x000000000000007FULL},
- Bitmap{0x0000000000000000ULL},Bitmap{0x0000000000000100ULL},Bitmap{0x0000000000000300ULL},Bitmap{0x0000000000000700ULL},Bitmap{0x0000000000000F00ULL},Bitmap{0x0000000000001F00ULL},Bitmap{0x0000000000003F00ULL},Bitmap{0x0000000000007F00ULL},
- Bitmap{0x0000000000000000ULL},Bitmap{0x0000000000010000ULL},Bitmap{0x0000000000030000ULL},Bitmap{0x0000000000070000ULL},Bitmap{0x00000000000F0000ULL},Bitmap{0x00000000001F0000ULL},Bitmap{0x00000000003F0000ULL},Bitmap{0x00000000007F0000ULL},
- Bitmap{0x0000000000000000ULL},Bitmap{0x0000000001000000ULL},Bitmap{0x0000000003000000ULL},Bitmap{0x0000000007000000ULL},Bitmap{0x000000000F000000ULL},Bitmap{0x000000001F000000ULL},Bitmap{0x000000003F000000ULL},Bitmap{0x000000007F000000ULL},
- Bitmap{0x0000000000000000ULL},Bitmap{0x0000000100000000ULL},Bitmap{0x0000000300000000ULL},Bitmap{0x0000000700000000ULL},Bitmap{0x0000000F00000000ULL},Bitmap{0x0000001F00000000ULL},Bitmap{0x0000003F00000000ULL},Bitmap{0x0000007F00000000ULL},
- Bitmap{0x0000000000000000ULL},Bitmap{0x0000010000000000ULL},Bitmap{0x0000030000000000ULL},Bitmap{0x0000070000000000ULL},Bitmap{0x00000F0000000000ULL},Bitmap{0x00001F0000000000ULL},Bitmap{0x00003F0000000000ULL},Bitmap{0x00007F0000000000ULL},
- Bitmap{0x0000000000000000ULL},Bitmap{0x0001000000000000ULL},Bitmap{0x0003000000000000ULL},Bitmap{0x0007000000000000ULL},Bitmap{0x000F000000000000ULL},Bitmap{0x001F000000000000ULL},Bitmap{0x003F000000000000ULL},Bitmap{0x007F000000000000ULL},
- Bitmap{0x0000000000000000ULL},Bitmap{0x0100000000000000ULL},Bitmap{0x0300000000000000ULL},Bitmap{0x0700000000000000ULL},Bitmap{0x0F00000000000000ULL},Bitmap{0x1F00000000000000ULL},Bitmap{0x3F00000000000000ULL},Bitmap{0x7F00000000000000ULL},
- },
-    TargetTable{ // north west
- Bitmap{0x0000000000000000ULL},Bitmap{0x0000000000000100ULL},Bitmap{0x0000000000010200ULL},Bitmap{0x0000000001020400ULL},Bitmap{0x0000000102040800ULL},Bitmap{0x0000010204081000ULL},Bitmap{0x0001020408102000ULL},Bitmap{0x0102040810204000ULL},
- Bitmap{0x0000000000000000ULL},Bitmap{0x0000000000010000ULL},Bitmap{0x0000000001020000ULL},Bitmap{0x0000000102040000ULL},Bitmap{0x0000010204080000ULL},Bitmap{0x0001020408100000ULL},Bitmap{0x0102040810200000ULL},Bitmap{0x0204081020400000ULL},
- Bitmap{0x0000000000000000ULL},Bitmap{0x0000000001000000ULL},Bitmap{0x0000000102000000ULL},Bitmap{0x0000010204000000ULL},Bitmap{0x0001020408000000ULL},Bitmap{0x0102040810000000ULL},Bitmap{0x0204081020000000ULL},Bitmap{0x0408102040000000ULL},
- Bitmap{0x0000000000000000ULL},Bitmap{0x0000000100000000ULL},Bitmap{0x0000010200000000ULL},Bitmap{0x0001020400000000ULL},Bitmap{0x0102040800000000ULL},Bitmap{0x0204081000000000ULL},Bitmap{0x0408102000000000ULL},Bitmap{0x0810204000000000ULL},
- Bitmap{0x0000000000000000ULL},Bitmap{0x0000010000000000ULL},Bitmap{0x0001020000000000ULL},Bitmap{0x0102040000000000ULL},Bitmap{0x0204080000000000ULL},Bitmap{0x0408100000000000ULL},Bitmap{0x0810200000000000ULL},Bitmap{0x1020400000000000ULL},
- Bitmap{0x0000000000000000ULL},Bitmap{0x0001000000000000ULL},Bitmap{0x0102000000000000ULL},Bitmap{0x0204000000000000ULL},Bitmap{0x0408000000000000ULL},Bitmap{0x0810000000000000ULL},Bitmap{0x1020000000000000ULL},Bitmap{0x2040000000000000ULL},
- Bitmap{0x0000000000000000ULL},Bitmap{0x0100000000000000ULL},Bitmap{0x0200000000000000ULL},Bitmap{0x0400000000000000ULL},Bitmap{0x0800000000000000ULL},Bitmap{0x1000000000000000ULL},Bitmap{0x2000000000000000ULL},Bitmap{0x4000000000000000ULL},
- Bitmap{0x0000000000000000ULL},Bitmap{0x0000000000000000ULL},Bitmap{0x0000000000000000ULL},Bitmap{0x0000000000000000ULL},Bitmap{0x0000000000000000ULL},Bitmap{0x0000000000000000ULL},Bitmap{0x0000000000000000ULL},Bitmap{0x0000000000000000ULL},
- },
+    detail::generate_ray_table(detail::ray_steps[0]), detail::generate_ray_table(detail::ray_steps[1]), detail::generate_ray_table(detail::ray_steps[2]),
+    detail::generate_ray_table(detail::ray_steps[3]), detail::generate_ray_table(detail::ray_steps[4]), detail::generate_ray_table(detail::ray_steps[5]),
+    detail::generate_ray_table(detail::ray_steps[6]), detail::generate_ray_table(detail::ray_steps[7]),
 };
-// clang-format on
 
-using RankTable = Table<Bitmap, 8, Rank>;
-using FileTable = Table<Bitmap, 8, File>;
+inline constexpr SquarePairTable between_table{detail::generate_between_table()};
+inline constexpr SquarePairTable line_table{detail::generate_line_table()};
+inline constexpr DistanceTable distance_table{detail::generate_distance_table()};
 
-inline constexpr RankTable rank_table{
-    Bitmap{0x00000000000000FFULL}, Bitmap{0x000000000000FF00ULL}, Bitmap{0x0000000000FF0000ULL}, Bitmap{0x00000000FF000000ULL},
-    Bitmap{0x000000FF0000000ULL},  Bitmap{0x0000FF0000000000ULL}, Bitmap{0x00FF000000000000ULL}, Bitmap{0xFF00000000000000ULL},
-};
+inline constexpr RankTable rank_table{detail::generate_rank_table()};
+inline constexpr FileTable file_table{detail::generate_file_table()};
 
-inline constexpr FileTable file_table{
-    Bitmap{0x0101010101010101ULL}, Bitmap{0x0202020202020202ULL}, Bitmap{0x0404040404040404ULL}, Bitmap{0x0808080808080808ULL},
-    Bitmap{0x1010101010101010ULL}, Bitmap{0x2020202020202020ULL}, Bitmap{0x4040404040404040ULL}, Bitmap{0x8080808080808080ULL},
-};
+/**
+ * \brief The squares strictly between two squares.
+ *
+ * \param from The first square.
+ * \param to The second square.
+ * \return The squares between both squares, if they share a rank, file or diagonal; an empty bitmap otherwise.
+ */
+constexpr auto between(const Square &from, const Square &to) -> Bitmap {
+    return between_table[from][to];
+}
+
+/**
+ * \brief The full line through two squares.
+ *
+ * \param from The first square.
+ * \param to The second square.
+ * \return The rank, file or diagonal through both squares, including both; an empty bitmap if they are not aligned.
+ */
+constexpr auto line(const Square &from, const Square &to) -> Bitmap {
+    return line_table[from][to];
+}
+
+/**
+ * \brief The Chebyshev distance between two squares.
+ *
+ * This is the number of king steps needed to get from one square to the other.
+ * \param from The first square.
+ * \param to The second square.
+ * \return The distance between the squares.
+ */
+constexpr auto distance(const Square &from, const Square &to) -> int {
+    return distance_table[from][to];
+}
 
 } // namespace chesscore::bitmaps
 
@@ -8,7 +8,9 @@
 #define CHESSCORE_BITMAP_H
 
 #include <bit>
+#include <cstddef>
 #include <cstdint>
+#include <iterator>
 
 #include "chesscore/square.h"
 
@@ -192,6 +194,106 @@ public:
      * \return The number of empty squares after the last piece is found.
      */
     constexpr auto empty_squares_after() const -> int { return std::countl_zero(m_bits); }
+
+    /**
+     * \brief The lowest occupied square.
+     *
+     * The bitmap must not be empty.
+     * \return The occupied square with the lowest index.
+     */
+    constexpr auto lsb() const -> Square { return Square::from_index(static_cast<std::size_t>(std::countr_zero(m_bits))); }
+
+    /**
+     * \brief The highest occupied square.
+     *
+     * The bitmap must not be empty.
+     * \return The occupied square with the highest index.
+     */
+    constexpr auto msb() const -> Square { return Square::from_index(static_cast<std::size_t>(63 - std::countl_zero(m_bits))); }
+
+    /**
+     * \brief Remove the lowest occupied square.
+     *
+     * The bitmap must not be empty.
+     * \return The removed square.
+     */
+    constexpr auto pop_lsb() -> Square {
+        const auto square = lsb();
+        m_bits &= m_bits - 1;
+        return square;
+    }
+
+    /**
+     * \brief Iterator over the occupied squares of a bitmap.
+     *
+     * Visits the occupied squares in the order of their index. The iterator
+     * works on a copy of the bits and removes the lowest bit when advancing.
+     */
+    class SquareIterator {
+    public:
+        using value_type = Square;             ///< Type of the visited elements.
+        using difference_type = std::ptrdiff_t; ///< Type of iterator distances.
+
+        constexpr SquareIterator() = default;
+
+        /**
+         * \brief Create an iterator over the given bits.
+         *
+         * \param bits The bits to visit.
+         */
+        explicit constexpr SquareIterator(std::uint64_t bits) : m_remaining{bits} {}
+
+        /**
+         * \brief The current square.
+         *
+         * \return The lowest square not yet visited.
+         */
+        constexpr auto operator*() const -> Square { return Square::from_index(static_cast<std::size_t>(std::countr_zero(m_remaining))); }
+
+        /**
+         * \brief Advance to the next occupied square.
+         *
+         * \return The iterator.
+         */
+        constexpr auto operator++() -> SquareIterator & {
+            m_remaining &= m_remaining - 1;
+            return *this;
+        }
+
+        /**
+         * \brief Advance to the next occupied square.
+         *
+         * \return The iterator before advancing.
+         */
+        constexpr auto operator++(int) -> SquareIterator {
+            auto previous = *this;
+            ++*this;
+            return previous;
+        }
+
+        /**
+         * \brief Check, if all squares have been visited.
+         *
+         * \return If no squares are left.
+         */
+        friend constexpr auto operator==(const SquareIterator &iterator, std::default_sentinel_t /*unused*/) -> bool { return iterator.m_remaining == 0; }
+    private:
+        std::uint64_t m_remaining{};
+    };
+
+    /**
+     * \brief Iterator to the first occupied square.
+     *
+     * \return The iterator.
+     */
+    constexpr auto begin() const -> SquareIterator { return SquareIterator{m_bits}; }
+
+    /**
+     * \brief Sentinel after the last occupied square.
+     *
+     * \return The sentinel.
+     */
+    constexpr auto end() const -> std::default_sentinel_t { return std::default_sentinel; }
 private:
     std::uint64_t m_bits{};
 
@@ -18,8 +18,8 @@
 namespace chesscore {
 
 class Square;
-enum class PieceType;
-enum class Color;
+enum class PieceType : std::uint8_t;
+enum class Color : std::uint8_t;
 class FenString;
 
 /**
@@ -50,7 +50,7 @@ static constexpr std::array<RayDirection, ray_direction_count> all_ray_direction
  * \param direction The compass direction.
  * \return The numerix index of the compass direction.
  */
-inline auto get_index(const RayDirection &direction) -> std::size_t {
+constexpr auto get_index(const RayDirection &direction) -> std::size_t {
     return static_cast<std::size_t>(direction);
 }
 
@@ -0,0 +1,122 @@
+/* ************************************************************************** *
+ * Chess Core                                                                 *
+ * Data structures and algorithms for chess                                   *
+ * ************************************************************************** */
+/** \file */
+
+#ifndef CHESSCORE_HASH_HISTORY_H
+#define CHESSCORE_HASH_HISTORY_H
+
+#include "chesscore/zobrist.h"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace chesscore {
+
+/**
+ * \brief The information recorded for one position of a history.
+ *
+ * Besides the hash of the position, the entry holds the additional hashes of
+ * the pieces, which are updated along with the moves.
+ */
+struct HistoryEntry {
+    ZobristHash hash{};                         ///< Hash of the position.
+    ZobristHash pawn_hash{};                    ///< Hash of the pawn structure.
+    std::array<ZobristHash, 2> non_pawn_hash{}; ///< Hashes of the non-pawn pieces for each color.
+    ZobristHash material_hash{};                ///< Hash of the material signature.
+    std::uint32_t previous{0};                  ///< Number of positions recorded before this one.
+};
+
+/**
+ * \brief A history of position hashes.
+ *
+ * Stores the hashes of the positions of a game, indexed by the ply of the
+ * position, i.e. the number of half moves since the start of the game. The
+ * history is a fixed-size ring buffer owned by the caller, so recording a hash
+ * never allocates memory, and copying a Position does not copy the history
+ * (see Position::attach_history()). Only the last capacity - 1 positions
+ * before the current one can be looked up. This covers the window of the
+ * fifty-move rule, which bounds the positions that can repeat.
+ */
+class HashHistory {
+public:
+    static constexpr std::size_t capacity{128}; ///< Number of positions stored (a power of two).
+
+    /**
+     * \brief Access the entry of a ply.
+     *
+     * \param ply The ply of the position.
+     * \return The entry of the position.
+     */
+    constexpr auto entry(std::size_t ply) -> HistoryEntry & { return m_entries[ply & index_mask]; }
+
+    /**
+     * \brief Access the entry of a ply.
+     *
+     * \param ply The ply of the position.
+     * \return The entry of the position.
+     */
+    constexpr auto entry(std::size_t ply) const -> const HistoryEntry & { return m_entries[ply & index_mask]; }
+
+    /**
+     * \brief Start a new line of positions.
+     *
+     * Clears the entry of the position, which has no predecessors in the
+     * history. The caller fills in the hashes.
+     * \param ply The ply of the position.
+     * \return The entry of the position.
+     */
+    constexpr auto start(std::size_t ply) -> HistoryEntry & { return entry(ply) = HistoryEntry{}; }
+
+    /**
+     * \brief Record the position reached by a move.
+     *
+     * Copies the entry of the previous ply, which has to hold the position the
+     * move was made in, so that the caller only needs to apply the changes of
+     * the move. Entries of later plies are not affected.
+     * \param ply The ply of the reached position.
+     * \return The entry of the reached position.
+     */
+    constexpr auto record(std::size_t ply) -> HistoryEntry & {
+        auto &reached = entry(ply);
+        reached = entry(ply - 1);
+        reached.previous = std::min(reached.previous + 1, max_previous);
+        return reached;
+    }
+
+    /**
+     * \brief Count the earlier occurrences of a position.
+     *
+     * Only every second entry is checked, since a position can only repeat
+     * with the same player to move. The search stops after the given number
+     * of half moves, which is usually the halfmove clock, as no position
+     * before the last irreversible move can repeat.
+     * \param ply The ply of the position.
+     * \param max_distance Maximum number of half moves to look back.
+     * \param max_count The search stops, after this many occurrences were found.
+     * \return Number of earlier occurrences of the position in the history.
+     */
+    constexpr auto count(std::size_t ply, std::size_t max_distance, int max_count) const -> int {
+        const auto &current = entry(ply);
+        const auto limit = std::min<std::size_t>(max_distance, current.previous);
+        int occurrences{0};
+        for (std::size_t distance = 2; distance <= limit && occurrences < max_count; distance += 2) {
+            if (entry(ply - distance).hash == current.hash) {
+                ++occurrences;
+            }
+        }
+        return occurrences;
+    }
+private:
+    static constexpr std::size_t index_mask{capacity - 1};
+    static constexpr std::uint32_t max_previous{capacity - 1};
+
+    std::array<HistoryEntry, capacity> m_entries{};
+};
+
+} // namespace chesscore
+
+#endif
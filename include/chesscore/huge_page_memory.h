@@ -0,0 +1,136 @@
+/* ************************************************************************** *
+ * Chess Core                                                                 *
+ * Data structures and algorithms for chess                                   *
+ * ************************************************************************** */
+/** \file */
+
+#ifndef CHESSCORE_HUGE_PAGE_MEMORY_H
+#define CHESSCORE_HUGE_PAGE_MEMORY_H
+
+#include <cstddef>
+#include <cstdint>
+
+namespace chesscore {
+
+/**
+ * \brief Kind of pages backing a memory block.
+ */
+enum class PageKind : std::uint8_t {
+    Regular,     ///< Regular pages of the operating system.
+    Advised,     ///< Regular allocation, advised to use transparent huge pages; the backing was not checked.
+    Transparent, ///< Regular allocation, backed by transparent huge pages.
+    Explicit,    ///< Explicitly reserved huge pages.
+};
+
+/**
+ * \brief Optional work done when allocating a HugePageMemory.
+ *
+ * Both steps cost time proportional to the block or the process, so they are
+ * off by default.
+ */
+struct HugePageOptions {
+    bool prefault{false}; ///< Touch the whole block right away, instead of on the first access of each page.
+    bool verify{false};   ///< Check in /proc/self/smaps, if transparent huge pages back the block.
+};
+
+/**
+ * \brief A large memory block that prefers huge pages.
+ *
+ * Random accesses into large hash tables cause many TLB misses with regular 4
+ * KB pages. Backing the table with 2 MB huge pages reduces them considerably.
+ *
+ * On Linux, the block is first requested from the reserved huge pages
+ * (MAP_HUGETLB). If none are available, it is mapped aligned to 2 MB and the
+ * kernel is advised to back it with transparent huge pages (MADV_HUGEPAGE).
+ * Whether the kernel actually does so depends on its configuration. It can be
+ * checked in /proc/self/smaps on request (see HugePageOptions), which touches
+ * the first huge page of the block. Otherwise, the pages are only faulted in
+ * on their first access, so allocating a large block is cheap. On other
+ * systems, or if both fail, the block is allocated with regular pages. The
+ * block is zero-initialized in every case.
+ *
+ * The block owns its memory and can be moved, but not copied.
+ */
+class HugePageMemory {
+public:
+    static constexpr std::size_t huge_page_size{2 * 1024 * 1024}; ///< Size of a huge page.
+
+    /**
+     * \brief Create an empty memory block.
+     */
+    HugePageMemory() = default;
+
+    /**
+     * \brief Allocate a memory block.
+     *
+     * \param size Size of the block in bytes.
+     * \param options Additional work to do after the allocation.
+     * \throws std::bad_alloc If the memory cannot be allocated.
+     */
+    explicit HugePageMemory(std::size_t size, HugePageOptions options = {});
+
+    HugePageMemory(const HugePageMemory &) = delete;
+    auto operator=(const HugePageMemory &) -> HugePageMemory & = delete;
+
+    /**
+     * \brief Take over the memory of another block.
+     *
+     * \param other The block to move from; it is empty afterwards.
+     */
+    HugePageMemory(HugePageMemory &&other) noexcept;
+
+    /**
+     * \brief Take over the memory of another block.
+     *
+     * The memory held before is released.
+     * \param other The block to move from; it is empty afterwards.
+     * \return This block.
+     */
+    auto operator=(HugePageMemory &&other) noexcept -> HugePageMemory &;
+
+    ~HugePageMemory();
+
+    /**
+     * \brief Access the memory.
+     *
+     * The memory is aligned to at least a cache line.
+     * \return Start of the memory block, or nullptr for an empty block.
+     */
+    auto data() const -> void * { return m_data; }
+
+    /**
+     * \brief Size of the memory block.
+     *
+     * \return The size in bytes, as requested.
+     */
+    auto size() const -> std::size_t { return m_size; }
+
+    /**
+     * \brief Kind of pages backing the memory.
+     *
+     * \return The kind of pages that was obtained or, for transparent huge
+     *         pages, observed after the allocation.
+     */
+    auto page_kind() const -> PageKind { return m_page_kind; }
+
+    /**
+     * \brief Check, if huge pages were obtained.
+     *
+     * The kernel may still split transparent huge pages later on. If the
+     * backing was not checked (PageKind::Advised), it is unknown and \c false
+     * is returned.
+     * \return If (at least part of) the memory is backed by huge pages.
+     */
+    auto huge_pages() const -> bool { return m_page_kind == PageKind::Transparent || m_page_kind == PageKind::Explicit; }
+private:
+    auto release() -> void;
+
+    void *m_data{nullptr};
+    std::size_t m_size{0};
+    std::size_t m_allocated_size{0};
+    PageKind m_page_kind{PageKind::Regular};
+};
+
+} // namespace chesscore
+
+#endif
@@ -13,6 +13,7 @@
 #include "chesscore/square.h"
 
 #include <algorithm>
+#include <cstdint>
 #include <optional>
 #include <string>
 #include <vector>
@@ -73,6 +74,123 @@ struct Move {
 
 auto to_string(const Move &move) -> std::string;
 
+/**
+ * \brief A move stored in 16 bits.
+ *
+ * A Move carries everything needed to make and undo it, which makes it large.
+ * PackedMove only stores the origin and target squares and a possible
+ * promotion, so that it can be kept in compact tables, such as a
+ * transposition table. The remaining information has to be recovered from the
+ * position the move is played in, e.g. by comparing it to generated moves with
+ * matches(). The value 0 (from A1 to A1) marks "no move".
+ */
+class PackedMove {
+public:
+    /**
+     * \brief Create an empty PackedMove.
+     */
+    constexpr PackedMove() = default;
+
+    /**
+     * \brief Create a PackedMove from a move.
+     *
+     * \param move The move to store.
+     */
+    constexpr PackedMove(const Move &move)
+        : m_bits{static_cast<std::uint16_t>(
+              move.from.index() | (move.to.index() << to_shift) |
+              (move.promoted.has_value() ? (static_cast<unsigned>(move.promoted->type) + 1U) << promotion_shift : 0U)
+          )} {}
+
+    /**
+     * \brief Create a PackedMove from its raw bits.
+     *
+     * \param bits The bits, as returned by bits().
+     * \return The PackedMove.
+     */
+    static constexpr auto from_bits(std::uint16_t bits) -> PackedMove {
+        PackedMove move;
+        move.m_bits = bits;
+        return move;
+    }
+
+    /**
+     * \brief The raw bits of the move.
+     *
+     * \return The bits encoding the move.
+     */
+    constexpr auto bits() const -> std::uint16_t { return m_bits; }
+
+    /**
+     * \brief Check, if a move is stored.
+     *
+     * \return If a move is stored.
+     */
+    constexpr auto has_value() const -> bool { return m_bits != 0; }
+
+    /**
+     * \brief The origin square of the move.
+     *
+     * \return The square the piece moves from.
+     */
+    constexpr auto from() const -> Square { return Square::from_index(m_bits & square_mask); }
+
+    /**
+     * \brief The target square of the move.
+     *
+     * \return The square the piece moves to.
+     */
+    constexpr auto to() const -> Square { return Square::from_index((m_bits >> to_shift) & square_mask); }
+
+    /**
+     * \brief The piece type a pawn is promoted to.
+     *
+     * \return The promoted piece type, if the move is a promotion.
+     */
+    constexpr auto promotion() const -> std::optional<PieceType> {
+        const auto promotion_bits = static_cast<unsigned>(m_bits >> promotion_shift);
+        if (promotion_bits == 0) {
+            return std::nullopt;
+        }
+        return static_cast<PieceType>(promotion_bits - 1U);
+    }
+
+    /**
+     * \brief Check, if a move is the stored move.
+     *
+     * Compares the squares and the promoted piece type.
+     * \param move The move to compare.
+     * \return If the move corresponds to the stored move.
+     */
+    constexpr auto matches(const Move &move) const -> bool { return has_value() && PackedMove{move} == *this; }
+
+    /**
+     * \brief Comparison of two PackedMoves.
+     *
+     * \param lhs Left-hand side of the comparison.
+     * \param rhs Right-hand side of the comparison.
+     * \return If both store the same move.
+     */
+    friend constexpr auto operator==(const PackedMove &lhs, const PackedMove &rhs) -> bool = default;
+private:
+    static constexpr unsigned to_shift{6U};         ///< Position of the target square.
+    static constexpr unsigned promotion_shift{12U}; ///< Position of the promoted piece type.
+    static constexpr unsigned square_mask{0x3FU};   ///< Mask for a square index.
+
+    std::uint16_t m_bits{0}; ///< The encoded move.
+};
+
+/**
+ * \brief Describes a null move.
+ *
+ * In a null move, the player to move passes. Only the parts of the game
+ * position that are needed to reverse the null move are stored.
+ */
+struct NullMove {
+    int halfmove_clock_before{};                                  ///< Halfmove clock before the null move.
+    std::optional<Square> en_passant_target_before{std::nullopt}; ///< En passant target square before the null move.
+};
+
 /**
  * \brief Partial comparison of two moves.
  *
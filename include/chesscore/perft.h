@@ -58,6 +58,15 @@ auto perft(Position &position, int depth, PerftCounter<Mode> &counter) -> void {
         return;
     }
 
+    if (depth == 1) {
+        // the leaves are only counted, so the moves need not be made
+        position.generate([&counter](const Move &) {
+            counter.count_node();
+            counter.count_leaf_node();
+        });
+        return;
+    }
+
     auto moves = position.all_legal_moves();
     for (const auto &move : moves) {
         position.make_move(move);
@@ -19,7 +19,7 @@ namespace chesscore {
 /**
  * \brief Type of a piece.
  */
-enum class PieceType { Pawn, Rook, Knight, Bishop, Queen, King };
+enum class PieceType : std::uint8_t { Pawn, Rook, Knight, Bishop, Queen, King };
 
 /**
  * \brief Number of available piece types.
@@ -44,6 +44,24 @@ constexpr auto get_index(const PieceType &type) -> std::size_t {
     return static_cast<std::size_t>(type);
 }
 
+/**
+ * \brief Material values of the piece types in centipawns.
+ *
+ * Ordered like the PieceType enumeration. The king is valued higher than all
+ * other material together, so that exchanges never trade it.
+ */
+static constexpr std::array<int, piece_type_count> piece_values{100, 500, 300, 300, 900, 10000};
+
+/**
+ * \brief Material value of a piece type.
+ *
+ * \param type The piece type.
+ * \return The value in centipawns.
+ */
+constexpr auto piece_value(const PieceType &type) -> int {
+    return piece_values[get_index(type)];
+}
+
 /**
  * \brief All the piece types that a pawn can promote into.
  */
@@ -73,10 +91,21 @@ auto piece_type_from_char(char letter) -> PieceType;
 /**
  * \brief Color of a piece or player.
  */
-enum class Color { White, Black };
+enum class Color : std::uint8_t { White, Black };
 
 auto to_string(Color color) -> std::string;
 
+/**
+ * \brief Get the numeric index of a color.
+ *
+ * White = 0, black = 1.
+ * \param color The color.
+ * \return The numeric index of the color.
+ */
+constexpr auto get_index(const Color &color) -> std::size_t {
+    return static_cast<std::size_t>(color);
+}
+
 /**
  * \brief Swap a color.
  *
@@ -10,9 +10,16 @@
 #include "chesscore/bitboard.h"
 #include "chesscore/board.h"
 #include "chesscore/fen.h"
+#include "chesscore/hash_history.h"
 #include "chesscore/position_types.h"
 #include "chesscore/zobrist.h"
 
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include <utility>
+
 namespace chesscore {
 
 /**
@@ -21,6 +28,13 @@ namespace chesscore {
  * Represents the state of a game of chess. It includes the current placement of
  * pieces on the board, the current turn, castling rights, the playerr to move,
  * and many other pieces of information that describe the state of the game.
+ *
+ * A Position is trivially copyable and does not own any heap memory, so a
+ * search can copy it with a single memcpy per ply (copy-make) instead of
+ * undoing moves. The board, the state, the hash and the pointer to the
+ * repetition history take 128 bytes, i.e. two cache lines. The history, which
+ * also holds the additional hashes of the pieces, is kept outside of the
+ * position and is shared by all copies, see attach_history().
  */
 class Position {
 public:
@@ -34,19 +48,22 @@ public:
     /**
      * \brief Create a Position from a FEN string.
      *
-     * The position is set up according to the FEN string.
+     * The position is set up according to the FEN string. Clocks that are
+     * out of the range of PositionState are clamped.
      * \param fen The FEN string.
      */
     explicit Position(const FenString &fen)
         : m_board{fen},
           m_state{
-              .side_to_move{fen.side_to_move()},
-              .fullmove_number{fen.fullmove_number()},
-              .halfmove_clock{fen.halfmove_clock()},
               .castling_rights{fen.castling_rights()},
-              .en_passant_target{fen.en_passant_square()}
+              .side_to_move{fen.side_to_move()},
+              .en_passant_target{fen.en_passant_square()},
+              .halfmove_clock{static_cast<std::uint8_t>(std::clamp<int>(fen.halfmove_clock(), 0, std::numeric_limits<std::uint8_t>::max()))},
+              .fullmove_number{static_cast<std::uint16_t>(std::clamp<int>(fen.fullmove_number(), 0, std::numeric_limits<std::uint16_t>::max()))}
           },
-          m_hash{ZobristHash::from_position(*this)} {}
+          m_hash{ZobristHash::from_position(*this)} {
+        m_board.update_check_info(m_state);
+    }
 
     /**
      * \brief Create the starting position.
@@ -125,6 +142,27 @@ public:
      */
     auto unmake_move(const Move &move) -> void;
 
+    /**
+     * \brief Perform a null move.
+     *
+     * The player to move passes: the side to move changes, a possible en
+     * passant target is cleared and the halfmove clock advances. The player to
+     * move must not be in check. The reached position is recorded in the
+     * history as the start of a new line, so that repetitions of positions
+     * before the null move are not detected.
+     * \return The information needed to undo the null move.
+     */
+    auto make_null_move() -> NullMove;
+
+    /**
+     * \brief Undo a null move.
+     *
+     * Reverts the position back to the state before the null move. This only
+     * works, if the null move was the last move made in this position.
+     * \param null_move The null move to undo, as returned by make_null_move().
+     */
+    auto unmake_null_move(const NullMove &null_move) -> void;
+
     /**
      * \brief The current state of the position.
      *
@@ -150,6 +188,75 @@ public:
      */
     auto capture_moves() const -> MoveList;
 
+    /**
+     * \brief Check, if the player to move has a legal move.
+     *
+     * Stops at the first legal move, instead of generating all of them.
+     * \return If there is at least one legal move.
+     */
+    auto has_legal_move() const -> bool { return m_board.has_legal_move(m_state); }
+
+    /**
+     * \brief Check, if a move could be made in this position, ignoring checks.
+     *
+     * See Bitboard::is_pseudo_legal().
+     * \param move The move.
+     * \return If the move is pseudo-legal.
+     */
+    auto is_pseudo_legal(const Move &move) const -> bool { return m_board.is_pseudo_legal(move, m_state); }
+
+    /**
+     * \brief Check, if a move is legal in this position.
+     *
+     * Validates a move of unknown origin in constant time, without generating
+     * the move list. See Bitboard::is_legal().
+     * \param move The move.
+     * \return If the move is legal.
+     */
+    auto is_legal(const Move &move) const -> bool { return m_board.is_legal(move, m_state); }
+
+    /**
+     * \brief Check, if a move gives check.
+     *
+     * See Bitboard::gives_check().
+     * \param move The move; it has to be legal.
+     * \return If the move puts the opposing king in check.
+     */
+    auto gives_check(const Move &move) const -> bool { return m_board.gives_check(move, m_state); }
+
+    /**
+     * \brief Generate all pseudo-legal moves.
+     *
+     * The moves may leave the own king in check; test the moves that are
+     * actually played with is_legal_after_pseudo().
+     * \return A list of all pseudo-legal moves for the player to move.
+     */
+    auto pseudo_legal_moves() const -> MoveList { return m_board.all_pseudo_legal_moves(m_state); }
+
+    /**
+     * \brief Check a pseudo-legal move for legality.
+     *
+     * \param move A move generated by pseudo_legal_moves().
+     * \return If the move does not leave the own king in check.
+     */
+    auto is_legal_after_pseudo(const Move &move) const -> bool { return m_board.is_legal_after_pseudo(move, m_state); }
+
+    /**
+     * \brief Hand all legal moves to a visitor.
+     *
+     * Calls the visitor for each legal move of the player to move, without
+     * building a move list. See Bitboard::generate().
+     * \tparam Visitor Callable with a `const Move &` parameter, returning
+     *         \c void or \c bool (\c false stops the generation).
+     * \param visitor The visitor.
+     * \param mode Generate legal or pseudo-legal moves.
+     * \return If all moves were generated, i.e. the visitor did not stop early.
+     */
+    template<typename Visitor>
+    auto generate(Visitor &&visitor, GenerationMode mode = GenerationMode::Legal) const -> bool {
+        return m_board.generate(m_state, std::forward<Visitor>(visitor), mode);
+    }
+
     /**
      * \brief Checks, if a king is under attack.
      *
@@ -160,16 +267,69 @@ public:
      */
     auto is_king_in_check(Color color) const -> bool;
 
+    /**
+     * \brief Pieces giving check.
+     *
+     * The pieces that attack the king of the player to move. The bitmap is
+     * computed once per move and cached in the state.
+     * \return The checking pieces.
+     */
+    auto checkers() const -> Bitmap { return m_state.checkers; }
+
+    /**
+     * \brief Absolutely pinned pieces.
+     *
+     * The pieces of the given color that cannot leave the line between their
+     * king and an attacking sliding piece. The bitmap is computed once per move
+     * and cached in the state.
+     * \param color The color of the pinned pieces.
+     * \return The pinned pieces.
+     */
+    auto pinned_pieces(Color color) const -> Bitmap { return m_state.king_blockers[get_index(color)] & m_board.bitmap(color); }
+
+    /**
+     * \brief Square of a king.
+     *
+     * \param color Color of the king.
+     * \return The square of the king, if there is a king of that color.
+     */
+    auto king_square(Color color) const -> std::optional<Square> { return m_state.king_square[get_index(color)]; }
+
     /**
      * \brief Determine the check state of the position.
      *
      * The check state of the player to move is returned. The player is in
      * check, if his king is under attack, but he still has legal moves. If
-     * there are no legal moves, the player is in checkmate.
+     * there are no legal moves, the player is in checkmate. Only the existence
+     * of a legal move is tested, the moves are not generated.
      * \return Check state for the player to move.
      */
     auto check_state() const -> CheckState;
 
+    /**
+     * \brief Static exchange evaluation of a move.
+     *
+     * Evaluates the sequence of captures on the target square of the move,
+     * where both players always recapture with their least valuable attacker
+     * and may stop capturing when it would lose material. Attackers hidden
+     * behind pieces that already captured (x-rays) join the exchange.
+     * \param move The move to evaluate.
+     * \return The material balance of the exchange in centipawns, from the
+     *         point of view of the moving player.
+     */
+    auto see(const Move &move) const -> int;
+
+    /**
+     * \brief Check the static exchange evaluation against a threshold.
+     *
+     * Equivalent to `see(move) >= threshold`, but returns early when the
+     * first capture alone decides the result.
+     * \param move The move to evaluate.
+     * \param threshold The threshold in centipawns.
+     * \return If the exchange gains at least the threshold.
+     */
+    auto see_ge(const Move &move, int threshold = 0) const -> bool;
+
     /**
      * \brief Get the piece placement of the position.
      *
@@ -185,6 +345,120 @@ public:
      */
     auto hash() const -> const ZobristHash & { return m_hash; }
 
+    /**
+     * \brief Hash of the position after a move.
+     *
+     * Computes the hash the position would have after making the move from
+     * the current hash and the move alone, without touching the board. This
+     * allows looking up (or prefetching) the entry of a child position before
+     * the move is made.
+     * \param move The move, valid in the current position.
+     * \return Hash of the resulting position.
+     */
+    auto key_after(const Move &move) const -> ZobristHash;
+
+    /**
+     * \brief Hash of the pawn structure.
+     *
+     * Only the pawns of both players contribute to this hash. Like the other
+     * hashes of the pieces, it is maintained incrementally in the attached
+     * history (see attach_history()). Without a history, or if the entry of
+     * the position was overwritten by a copy, it is computed from the board.
+     * \return Hash of the pawn structure.
+     */
+    auto pawn_hash() const -> ZobristHash;
+
+    /**
+     * \brief Hash of the non-pawn pieces of one player.
+     *
+     * All pieces of the given color except pawns (including the king)
+     * contribute to this hash.
+     * \param color The color of the player.
+     * \return Hash of the non-pawn pieces.
+     */
+    auto non_pawn_hash(Color color) const -> ZobristHash;
+
+    /**
+     * \brief Hash of the material signature.
+     *
+     * The hash only depends on the number of pieces of each type and color,
+     * not on their placement.
+     * \return Hash of the material signature.
+     */
+    auto material_hash() const -> ZobristHash;
+
+    /**
+     * \brief Number of pieces of a kind.
+     *
+     * \param piece The piece to count.
+     * \return Number of pieces of the given type and color on the board.
+     */
+    auto piece_count(const Piece &piece) const -> int { return m_board.piece_count(piece); }
+
+    /**
+     * \brief Record the positions reached from this position in a history.
+     *
+     * Each move made afterwards records the hashes of the reached position in
+     * the history, which are needed to detect repetitions and to look up the
+     * hashes of the pieces without scanning the board. The history is owned
+     * by the caller and has to outlive the position. Copies of the position
+     * refer to the same history. A move only writes the entry of the reached
+     * position, so a copy can make moves without disturbing the position it
+     * was copied from (copy-make), as long as only one line of moves is
+     * followed from each position at a time.
+     *
+     * Copies that are kept alive side by side should not share a history:
+     * when two copies of the same ply both make a move, the second move
+     * overwrites the entry of the first one. A position detects this by
+     * comparing the recorded hash with its own hash. It then computes the
+     * hashes of the pieces from the board, and the next move starts a new
+     * line in the history, so the overwritten copy stays correct, but does not
+     * detect repetitions of the positions before the overwritten entry.
+     * Attach a separate history to each of these copies to keep them.
+     *
+     * If the position was attached to another history before, the entries of
+     * that history are copied, so that repetitions of earlier positions are
+     * still found.
+     * \param history The history.
+     */
+    auto attach_history(HashHistory &history) -> void;
+
+    /**
+     * \brief The history the positions are recorded in.
+     *
+     * \return The history, or \c nullptr, if no history is attached.
+     */
+    auto history() const -> const HashHistory * { return m_history; }
+
+    /**
+     * \brief Check for a repetition of the current position.
+     *
+     * Checks, if the current position occurred at least the given number of
+     * times (including the current occurrence) since the last irreversible
+     * move. Only positions recorded in the attached history are known, so
+     * without a history (or if the entry of the position was overwritten by a
+     * copy, see attach_history()) no repetition is detected for a count
+     * larger than 1. The history keeps the last
+     * HashHistory::capacity - 1 (i.e. 127) positions before the current one;
+     * earlier positions are not considered, even if the halfmove clock is
+     * larger (which is only possible beyond the fifty-move rule). Use a count
+     * of 3 for the threefold repetition rule. A search usually treats the
+     * first repetition (count 2) as a draw.
+     * \param count Number of occurrences.
+     * \return If the position occurred at least count times.
+     */
+    auto is_repetition(int count = 3) const -> bool;
+
+    /**
+     * \brief Check the fifty-move rule.
+     *
+     * The rule applies, when no capture and no pawn move was made in the last
+     * fifty moves of each player. This does not consider, whether the last
+     * move delivered checkmate.
+     * \return If a draw can be claimed by the fifty-move rule.
+     */
+    auto is_fifty_move_draw() const -> bool { return m_state.halfmove_clock >= fifty_move_rule_plies; }
+
     /**
      * \brief Comparison of two positions.
      *
@@ -193,12 +467,19 @@ public:
      */
     auto operator==(const Position &rhs) const -> bool;
 private:
-    Bitboard m_board{};      ///< Current placement of pieces on the board.
-    PositionState m_state{}; ///< The current state of the position.
-    ZobristHash m_hash{};    ///< Hash of the position.
+    Bitboard m_board{};              ///< Current placement of pieces on the board.
+    PositionState m_state{};         ///< The current state of the position.
+    ZobristHash m_hash{};            ///< Hash of the position.
+    HashHistory *m_history{nullptr}; ///< History the positions are recorded in (not owned).
 
-    auto move_piece_hash(const Move &move) -> void;
-    auto unmove_piece_hash(const Move &move) -> void;
+    static constexpr int fifty_move_rule_plies{100};
+
+    auto ply() const -> std::size_t { return static_cast<std::size_t>(2 * (m_state.fullmove_number - 1) + (m_state.side_to_move == Color::Black ? 1 : 0)); }
+
+    auto owns_history_entry() const -> bool { return m_history->entry(ply()).hash == m_hash; }
+    auto recorded_keys() const -> const HistoryEntry *;
+    auto start_history() -> void;
+    auto claim_history_entry() -> void;
     auto updateCastlingRights(const Move &move) -> void;
     auto updateFullmoveNumber() -> void;
     auto updateHalfmoveClock(const Move &move) -> void;
@@ -209,6 +490,9 @@ private:
     auto resetCastlingRights(const Move &move) -> void;
 };
 
+static_assert(std::is_trivially_copyable_v<Position>);
+static_assert(sizeof(Position) <= 128);
+
 } // namespace chesscore
 
 #endif
@@ -7,19 +7,58 @@
 #ifndef CHESSCORE_POSITION_TYPES_H
 #define CHESSCORE_POSITION_TYPES_H
 
+#include "chesscore/bitmap.h"
 #include "chesscore/piece.h"
 #include "chesscore/square.h"
 
+#include <array>
+#include <cstdint>
+
 namespace chesscore {
 
 /**
  * \brief Describes the availability of castling for each player.
+ *
+ * The four castling rights are stored as bits of a 4-bit mask. The mask can
+ * directly be used as an index, e.g. for the Zobrist castling keys.
  */
-struct CastlingRights {
-    bool white_kingside{false};  ///< White can castle on the kingside.
-    bool white_queenside{false}; ///< White can castle on the queenside.
-    bool black_kingside{false};  ///< Black can castle on the kingside.
-    bool black_queenside{false}; ///< Black can castle on the queenside.
+class CastlingRights {
+public:
+    static constexpr std::uint8_t BlackQueenside{0b0001}; ///< Black can castle on the queenside.
+    static constexpr std::uint8_t BlackKingside{0b0010};  ///< Black can castle on the kingside.
+    static constexpr std::uint8_t WhiteQueenside{0b0100}; ///< White can castle on the queenside.
+    static constexpr std::uint8_t WhiteKingside{0b1000};  ///< White can castle on the kingside.
+    static constexpr std::uint8_t AllRights{0b1111};      ///< All castling rights.
+
+    /**
+     * \brief Number of different combinations of castling rights.
+     */
+    static constexpr std::size_t count{16};
+
+    /**
+     * \brief Create an object without castling rights.
+     */
+    constexpr CastlingRights() = default;
+
+    /**
+     * \brief Create castling rights from a bit mask.
+     *
+     * \param mask Combination of the castling right bits.
+     */
+    explicit constexpr CastlingRights(std::uint8_t mask) : m_mask{static_cast<std::uint8_t>(mask & AllRights)} {}
+
+    /**
+     * \brief Create castling rights from the availability of each right.
+     *
+     * \param white_kingside White can castle on the kingside.
+     * \param white_queenside White can castle on the queenside.
+     * \param black_kingside Black can castle on the kingside.
+     * \param black_queenside Black can castle on the queenside.
+     */
+    constexpr CastlingRights(bool white_kingside, bool white_queenside, bool black_kingside, bool black_queenside)
+        : m_mask{static_cast<std::uint8_t>(
+              (white_kingside ? WhiteKingside : 0) | (white_queenside ? WhiteQueenside : 0) | (black_kingside ? BlackKingside : 0) | (black_queenside ? BlackQueenside : 0)
+          )} {}
 
     /**
      * \brief Quality comparison for castling availability.
@@ -30,33 +69,69 @@ struct CastlingRights {
      * \param rhs Right-hand side of the comparison.
      * \return Equality of the two objects.
      */
-    friend auto operator==(const CastlingRights &lhs, const CastlingRights &rhs) -> bool = default;
+    friend constexpr auto operator==(const CastlingRights &lhs, const CastlingRights &rhs) -> bool = default;
 
     /**
-     * \brief Get the castling rights for a a player.
+     * \brief The castling rights as a bit mask.
      *
-     * Query the castling rights for a player and a side (kingside/queenside).
-     * The letter given has the same meaning as in a FEN string. (K = kingside
-     * castling of the white king, q = queenside castling of the black king,
-     * ...)
-     * \param piece The castling type as described above.
-     * @return If the castling right is available.
+     * \return The bit mask.
      */
-    auto operator[](char piece) const -> const bool & {
-        switch (piece) {
-        case 'K':
-            return white_kingside;
-        case 'Q':
-            return white_queenside;
-        case 'k':
-            return black_kingside;
-        case 'q':
-            return black_queenside;
-        default:
-            throw OutOfRange("Invalid castling type");
-        }
+    constexpr auto mask() const -> std::uint8_t { return m_mask; }
+
+    /**
+     * \brief Check, if a castling right is available.
+     *
+     * \param right The bit of the castling right.
+     * \return If the castling right is available.
+     */
+    constexpr auto has(std::uint8_t right) const -> bool { return (m_mask & right) != 0; }
+
+    /**
+     * \brief Grant or revoke a castling right.
+     *
+     * \param right The bit of the castling right.
+     * \param available If the right is granted or revoked.
+     */
+    constexpr auto set(std::uint8_t right, bool available = true) -> void {
+        m_mask = static_cast<std::uint8_t>(available ? (m_mask | right) : (m_mask & ~right));
     }
 
+    /**
+     * \brief Keep only the given castling rights.
+     *
+     * Removes all rights that are not part of the given mask.
+     * \param rights The bit mask of the rights to keep.
+     */
+    constexpr auto keep(std::uint8_t rights) -> void { m_mask &= rights; }
+
+    /**
+     * \brief Check, if white can castle on the kingside.
+     *
+     * \return If the right is available.
+     */
+    constexpr auto white_kingside() const -> bool { return has(WhiteKingside); }
+
+    /**
+     * \brief Check, if white can castle on the queenside.
+     *
+     * \return If the right is available.
+     */
+    constexpr auto white_queenside() const -> bool { return has(WhiteQueenside); }
+
+    /**
+     * \brief Check, if black can castle on the kingside.
+     *
+     * \return If the right is available.
+     */
+    constexpr auto black_kingside() const -> bool { return has(BlackKingside); }
+
+    /**
+     * \brief Check, if black can castle on the queenside.
+     *
+     * \return If the right is available.
+     */
+    constexpr auto black_queenside() const -> bool { return has(BlackQueenside); }
+
     /**
      * \brief Get the castling rights for a a player.
      *
@@ -67,36 +142,83 @@ struct CastlingRights {
      * \param piece The castling type as described above.
      * @return If the castling right is available.
      */
-    auto operator[](char piece) -> bool & {
+    auto operator[](char piece) const -> bool { return has(right_from_char(piece)); }
+
+    /**
+     * \brief Get the bit of a castling right from its FEN letter.
+     *
+     * \param piece The castling type (K, Q, k or q).
+     * \return The bit of the castling right.
+     * \throws OutOfRange If the letter is not a valid castling type.
+     */
+    static auto right_from_char(char piece) -> std::uint8_t {
         switch (piece) {
         case 'K':
-            return white_kingside;
+            return WhiteKingside;
         case 'Q':
-            return white_queenside;
+            return WhiteQueenside;
         case 'k':
-            return black_kingside;
+            return BlackKingside;
         case 'q':
-            return black_queenside;
+            return BlackQueenside;
         default:
             throw OutOfRange("Invalid castling type");
         }
     }
 
+    /**
+     * \brief The castling rights that are kept when a square is involved in a move.
+     *
+     * A move from or to one of the king or rook starting squares removes the
+     * corresponding rights. The new castling rights after a move are the old
+     * rights, masked with the values for the origin and the target square.
+     * \param square The origin or target square of a move.
+     * \return The bit mask of the rights that are not affected.
+     */
+    static constexpr auto preserved_by(const Square &square) -> std::uint8_t;
+
     /**
      * \brief Generate an object with all castling rights.
      *
      * \return Object that has all the castling rights.
      */
-    static auto all() -> CastlingRights { return CastlingRights{true, true, true, true}; }
+    static constexpr auto all() -> CastlingRights { return CastlingRights{AllRights}; }
 
     /**
      * \brief Generate an object with no castling rights.
      *
      * \return Object that has no castling rights.
      */
-    static auto none() -> CastlingRights { return CastlingRights{false, false, false, false}; }
+    static constexpr auto none() -> CastlingRights { return CastlingRights{}; }
+private:
+    std::uint8_t m_mask{0}; ///< The available castling rights.
 };
 
+static_assert(sizeof(CastlingRights) == 1);
+
+namespace detail {
+
+constexpr auto generate_preserved_castling_rights() -> std::array<std::uint8_t, Square::count> {
+    constexpr auto all_rights = CastlingRights::AllRights;
+    std::array<std::uint8_t, Square::count> rights{};
+    rights.fill(all_rights);
+    rights[0] = static_cast<std::uint8_t>(all_rights & ~CastlingRights::WhiteQueenside);                                   // a1
+    rights[4] = static_cast<std::uint8_t>(all_rights & ~(CastlingRights::WhiteKingside | CastlingRights::WhiteQueenside)); // e1
+    rights[7] = static_cast<std::uint8_t>(all_rights & ~CastlingRights::WhiteKingside);                                    // h1
+    rights[56] = static_cast<std::uint8_t>(all_rights & ~CastlingRights::BlackQueenside);                                  // a8
+    rights[60] = static_cast<std::uint8_t>(all_rights & ~(CastlingRights::BlackKingside | CastlingRights::BlackQueenside)); // e8
+    rights[63] = static_cast<std::uint8_t>(all_rights & ~CastlingRights::BlackKingside);                                   // h8
+    return rights;
+}
+
+inline constexpr auto preserved_castling_rights = generate_preserved_castling_rights();
+
+} // namespace detail
+
+constexpr auto CastlingRights::preserved_by(const Square &square) -> std::uint8_t {
+    return detail::preserved_castling_rights[square.index()];
+}
+
 /**
  * \brief Possible check states of a position.
  */
@@ -120,22 +242,54 @@ enum class CheckState {
  */
 auto check_state_symbol(CheckState state) -> std::string;
 
+/**
+ * \brief The state of a position besides the placement of the pieces.
+ *
+ * Besides the game state, the struct caches information about checks and pins
+ * that is derived from the piece placement. Position computes this information
+ * once per move. The blockers of a king are the pieces of both colors that
+ * shield it from an opposing slider: the own ones are pinned, the opposing ones
+ * can give discovered check. The check squares are the squares from which a
+ * bishop or a rook of the player to move would attack the opposing king. If a
+ * state is set up manually, the cached information is unavailable (no king
+ * squares are set) and is not used.
+ *
+ * The members are ordered by size, so that the state is packed without holes.
+ * The clocks are stored in small integers, so that the state fits into 48
+ * bytes: the halfmove clock saturates at 255, which is well beyond the
+ * fifty-move rule.
+ */
 struct PositionState {
-    Color side_to_move{Color::White};                       ///< The player who moves next.
-    int fullmove_number{1};                                 ///< Number of the next move.
-    int halfmove_clock{0};                                  ///< Half-move clock for the fifty-move rule.
     CastlingRights castling_rights{CastlingRights::none()}; ///< Castling rights.
-    std::optional<Square> en_passant_target{};              ///< A possible en passant target square.
+    Color side_to_move{Color::White};                       ///< The player who moves next.
+    PackedSquare en_passant_target{};                       ///< A possible en passant target square.
+    std::array<PackedSquare, 2> king_square{};              ///< Square of the king for each color (cached).
+    std::uint8_t halfmove_clock{0};                         ///< Half-move clock for the fifty-move rule.
+    std::uint16_t fullmove_number{1};                       ///< Number of the next move.
+    Bitmap checkers{};                                      ///< Pieces giving check to the king of the player to move (cached).
+    std::array<Bitmap, 2> king_blockers{};                  ///< Pieces blocking sliding attacks on the king of each color (cached).
+    Bitmap bishop_check_squares{};                          ///< Squares from which a bishop checks the opposing king (cached).
+    Bitmap rook_check_squares{};                            ///< Squares from which a rook checks the opposing king (cached).
+
+    /**
+     * \brief Check, if the cached check information is available.
+     *
+     * \return If king square, checkers, blockers and check squares are set for the player to move.
+     */
+    auto has_check_info() const -> bool { return king_square[get_index(side_to_move)].has_value(); }
 
     /**
      * \brief Comparison of two PositionStates.
      *
+     * Only the game state is compared, not the cached information.
      * \param rhs The state to compare to.
      * \return If the states are equal.
      */
     auto operator==(const PositionState &rhs) const -> bool;
 };
 
+static_assert(sizeof(PositionState) == 48);
+
 } // namespace chesscore
 
 #endif
@@ -0,0 +1,193 @@
+/* ************************************************************************** *
+ * Chess Core                                                                 *
+ * Data structures and algorithms for chess                                   *
+ * ************************************************************************** */
+/** \file */
+
+#ifndef CHESSCORE_SEARCH_H
+#define CHESSCORE_SEARCH_H
+
+#include "chesscore/move.h"
+#include "chesscore/position.h"
+#include "chesscore/transposition_table.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+namespace chesscore::search {
+
+inline constexpr int max_ply{128};         ///< Maximum distance from the root the search looks at.
+inline constexpr int max_depth{64};        ///< Maximum nominal search depth.
+inline constexpr int mate_score{32000};    ///< Score of a position, where the player to move gives mate.
+inline constexpr int infinite_score{32001}; ///< A score beyond all possible scores.
+
+/**
+ * \brief Check, if a score announces a mate.
+ *
+ * \param score The score.
+ * \return If the score is a mate score for either side.
+ */
+constexpr auto is_mate_score(int score) -> bool {
+    return score >= mate_score - max_ply || score <= -mate_score + max_ply;
+}
+
+/**
+ * \brief Number of moves until mate.
+ *
+ * \param score A mate score (see is_mate_score()).
+ * \return Number of moves (not plies) until mate; negative, if the player to
+ *         move gets mated.
+ */
+constexpr auto mate_in(int score) -> int {
+    return score > 0 ? (mate_score - score + 1) / 2 : -(mate_score + score) / 2;
+}
+
+/**
+ * \brief Type of an evaluation function.
+ *
+ * An evaluation function scores a position in centipawns from the view of the
+ * player to move.
+ */
+using Evaluator = auto (*)(const Position &position) -> int;
+
+/**
+ * \brief A simple static evaluation.
+ *
+ * Counts the material and adds small bonuses for centralized pieces and
+ * advanced pawns.
+ * \param position The position to evaluate.
+ * \return Score of the position in centipawns from the view of the player to
+ *         move.
+ */
+auto evaluate(const Position &position) -> int;
+
+/**
+ * \brief Limits of a search.
+ *
+ * A limit of 0 means no limit for nodes and time. The search always completes
+ * depth 1, even if a limit is reached earlier.
+ */
+struct Limits {
+    int depth{max_depth};                  ///< Maximum depth to search.
+    std::uint64_t nodes{0};                ///< Maximum number of nodes to search.
+    std::chrono::milliseconds time{0};     ///< Maximum time to search.
+    int multi_pv{1};                       ///< Number of best moves to report.
+    int threads{1};                        ///< Number of threads to search with.
+};
+
+/**
+ * \brief A principal variation.
+ */
+struct PvLine {
+    MoveList moves{}; ///< The moves of the variation, starting with the move from the root.
+    int score{0};     ///< Score of the variation from the view of the player to move.
+};
+
+/**
+ * \brief Result of a search.
+ */
+struct Result {
+    std::optional<Move> best_move{}; ///< The best move; empty, if there are no legal moves.
+    int score{0};                    ///< Score of the best move from the view of the player to move.
+    int depth{0};                    ///< Depth of the last completed iteration.
+    std::uint64_t nodes{0};          ///< Number of nodes searched by all threads.
+    MoveList pv{};                   ///< Principal variation of the best move.
+    std::vector<PvLine> lines{};     ///< Principal variations of the best moves (multi-PV), best first.
+};
+
+/**
+ * \brief State of a Searcher.
+ */
+enum class SearchState : std::uint8_t {
+    Idle,      ///< No search is running.
+    Searching, ///< A search is running.
+    Stopping   ///< A search is running and has to stop.
+};
+
+/**
+ * \brief An alpha-beta search.
+ *
+ * Implements an iterative-deepening principal variation search with a
+ * transposition table, null-move pruning, late move reductions and a
+ * quiescence search over captures. Moves are ordered by the move of the
+ * transposition table, by MVV-LVA for captures and by killer and history
+ * heuristics for quiet moves.
+ *
+ * With more than one thread, the search uses Lazy SMP: all threads search the
+ * same position independently and share their results only through the
+ * lockless transposition table. The helper threads search at alternating
+ * depths, so that they fill the table with results the main thread needs
+ * next. The result is taken from the main thread.
+ *
+ * In multi-PV mode, the root is searched once for each reported line,
+ * excluding the moves of the lines already found.
+ *
+ * All buffers of a search are allocated before it starts, so the search
+ * itself does not allocate memory.
+ */
+class Searcher {
+public:
+    /**
+     * \brief Create a searcher.
+     *
+     * \param hash_megabytes Size of the transposition table in megabytes.
+     * \param evaluator The static evaluation.
+     */
+    explicit Searcher(std::size_t hash_megabytes = 16, Evaluator evaluator = evaluate) : m_table{hash_megabytes}, m_evaluator{evaluator} {}
+
+    /**
+     * \brief Search a position.
+     *
+     * Blocks until the search finished, i.e. a limit is reached or stop()
+     * was called.
+     * \param position The position to search.
+     * \param limits The limits of the search.
+     * \return The result of the search.
+     */
+    auto search(const Position &position, const Limits &limits) -> Result;
+
+    /**
+     * \brief Stop a running search.
+     *
+     * Can be called from any thread. The running search returns the result of
+     * the last completed iteration. The request belongs to the running search:
+     * a stop while no search is running is ignored and does not affect the
+     * next search.
+     */
+    auto stop() -> void {
+        auto expected = SearchState::Searching;
+        m_state.compare_exchange_strong(expected, SearchState::Stopping, std::memory_order_relaxed);
+    }
+
+    /**
+     * \brief Remove all results of previous searches.
+     */
+    auto clear() -> void { m_table.clear(); }
+
+    /**
+     * \brief Change the size of the transposition table.
+     *
+     * Must not be called during a search.
+     * \param megabytes Size of the transposition table in megabytes.
+     */
+    auto resize_table(std::size_t megabytes) -> void { m_table.resize(megabytes); }
+
+    /**
+     * \brief The transposition table of the searcher.
+     *
+     * \return The transposition table.
+     */
+    auto table() const -> const TranspositionTable & { return m_table; }
+private:
+    TranspositionTable m_table;
+    Evaluator m_evaluator;
+    std::atomic<SearchState> m_state{SearchState::Idle};
+};
+
+} // namespace chesscore::search
+
+#endif
@@ -0,0 +1,212 @@
+/* ************************************************************************** *
+ * Chess Core                                                                 *
+ * Data structures and algorithms for chess                                   *
+ * ************************************************************************** */
+/** \file */
+
+#ifndef CHESSCORE_SHARED_HASH_TABLE_H
+#define CHESSCORE_SHARED_HASH_TABLE_H
+
+#include "chesscore/chesscore.h"
+#include "chesscore/zobrist.h"
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+
+namespace chesscore {
+
+/**
+ * \brief Exception thrown, if a shared hash table cannot be opened.
+ */
+class SharedMemoryError : public ChessException {
+public:
+    /**
+     * \brief Construct a new exception.
+     *
+     * \param message Description of the error.
+     */
+    SharedMemoryError(const std::string &message) : ChessException{message} {}
+};
+
+/**
+ * \brief A hash table shared between processes, keyed by the Zobrist hash.
+ *
+ * The table lives in a named POSIX shared memory segment, so that several
+ * processes on one host can share results for positions, such as perft
+ * subtree counts or analysis scores. Each entry stores a 64 bit value. If the
+ * value depends on more than the position (like the depth of a perft count),
+ * this has to be mixed into the key by the user.
+ *
+ * The segment starts with a header holding a magic number, a format version,
+ * the size of the table and the process id of its creator. The first process
+ * creates and initializes the segment, later processes attach to it and check
+ * that the header matches. The creator holds a lock on the segment until it
+ * is initialized. If the creator died before, its lock is released, and a
+ * later process removes the stale segment and creates it anew. The recovery
+ * holds the same lock and only removes the name, if it still refers to the
+ * stale segment, so several processes can recover at the same time.
+ *
+ * Like TranspositionTable, the table uses buckets of the size of a cache line
+ * and entries that store the key XORed with the value. Accesses use atomic
+ * operations without locks, so that torn entries are detected as misses. This
+ * requires lock-free 64 bit atomics, which are address-free and can therefore
+ * be shared between processes.
+ *
+ * The segment stays alive after all processes detached from it, until it is
+ * removed with remove().
+ */
+class SharedHashTable {
+public:
+    static constexpr std::uint32_t format_version{2};   ///< Version of the memory layout.
+    static constexpr std::size_t entries_per_bucket{4}; ///< Number of entries in one bucket.
+
+    /**
+     * \brief Create a shared table or attach to an existing one.
+     *
+     * The number of buckets is the largest power of two that fits into the
+     * given size. An existing table must have been created with the same size.
+     * A segment that is still not initialized after waiting for two seconds
+     * is removed and created again, if its creator released its lock, i.e.
+     * no longer exists.
+     * \param name Name of the shared memory segment; a leading '/' is added,
+     *             if missing.
+     * \param megabytes Maximum size of the table in megabytes.
+     * \throws SharedMemoryError If the segment cannot be created or attached,
+     *         if it does not match the requested table, or if its creator is
+     *         still alive, but did not initialize it in time.
+     */
+    SharedHashTable(const std::string &name, std::size_t megabytes);
+
+    SharedHashTable(const SharedHashTable &) = delete;
+    auto operator=(const SharedHashTable &) -> SharedHashTable & = delete;
+
+    /**
+     * \brief Take over the attachment of another table.
+     *
+     * \param other The table to move from; it is detached afterwards.
+     */
+    SharedHashTable(SharedHashTable &&other) noexcept;
+
+    /**
+     * \brief Take over the attachment of another table.
+     *
+     * Detaches from the segment this table was attached to.
+     * \param other The table to move from; it is detached afterwards.
+     * \return This table.
+     */
+    auto operator=(SharedHashTable &&other) noexcept -> SharedHashTable &;
+
+    /**
+     * \brief Detach from the shared memory segment.
+     */
+    ~SharedHashTable();
+
+    /**
+     * \brief Detach from the shared memory segment.
+     *
+     * The segment itself, and its contents, stay available to other
+     * processes. The table cannot be used afterwards.
+     */
+    auto detach() -> void;
+
+    /**
+     * \brief Check, if the table is attached to a segment.
+     *
+     * \return If the table can be used.
+     */
+    auto attached() const -> bool { return m_mapping != nullptr; }
+
+    /**
+     * \brief Check, if this process created the segment.
+     *
+     * \return If the segment was created when this table was opened.
+     */
+    auto created() const -> bool { return m_created; }
+
+    /**
+     * \brief Name of the shared memory segment.
+     *
+     * \return The name, including the leading '/'.
+     */
+    auto name() const -> const std::string & { return m_name; }
+
+    /**
+     * \brief Number of buckets in the table.
+     *
+     * \return The number of buckets.
+     */
+    auto bucket_count() const -> std::size_t { return m_bucket_count; }
+
+    /**
+     * \brief Look up the value stored for a position.
+     *
+     * \param hash Hash of the position.
+     * \return The stored value, if the position is found.
+     */
+    auto probe(const ZobristHash &hash) const -> std::optional<std::uint64_t>;
+
+    /**
+     * \brief Store a value for a position.
+     *
+     * Overwrites the entry of the same position, or an empty entry of the
+     * bucket. In a full bucket, one of the entries is replaced, as selected by
+     * the hash.
+     * \param hash Hash of the position.
+     * \param value The value to store.
+     */
+    auto store(const ZobristHash &hash, std::uint64_t value) -> void;
+
+    /**
+     * \brief Remove all entries from the table.
+     *
+     * Affects all processes attached to the table.
+     */
+    auto clear() -> void;
+
+    /**
+     * \brief Remove a shared memory segment.
+     *
+     * Processes still attached keep their mapping, but the name can be
+     * reused for a new segment.
+     * \param name Name of the shared memory segment.
+     * \return If the segment existed and was removed.
+     */
+    static auto remove(const std::string &name) -> bool;
+private:
+    struct Entry {
+        std::atomic<std::uint64_t> key{0};
+        std::atomic<std::uint64_t> value{0};
+    };
+
+    struct alignas(64) Bucket {
+        std::array<Entry, entries_per_bucket> entries;
+    };
+    static_assert(sizeof(Bucket) == 64);
+    static_assert(std::atomic<std::uint64_t>::is_always_lock_free);
+
+    struct alignas(64) Header {
+        std::atomic<std::uint64_t> magic{0};
+        std::uint32_t version{0};
+        std::uint32_t bucket_size{0};
+        std::uint64_t bucket_count{0};
+        std::atomic<std::int64_t> creator{0};
+    };
+
+    auto open_segment(std::size_t bucket_count) -> bool;
+    auto bucket(const ZobristHash &hash) const -> Bucket & { return m_buckets[hash.hash() & (m_bucket_count - 1)]; }
+
+    std::string m_name{};
+    void *m_mapping{nullptr};
+    std::size_t m_mapping_size{0};
+    Bucket *m_buckets{nullptr};
+    std::size_t m_bucket_count{0};
+    bool m_created{false};
+};
+
+} // namespace chesscore
+
+#endif
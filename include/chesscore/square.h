@@ -8,6 +8,8 @@
 #define CHESSCORE_SQUARE_H
 
 #include <algorithm>
+#include <cstdint>
+#include <optional>
 
 #include "chesscore/chesscore.h"
 
@@ -208,6 +210,18 @@ public:
      */
     static constexpr int count = File::max_file * Rank::max_rank;
 
+    /**
+     * \brief Create a square from its linear index.
+     *
+     * The inverse of index(): A1 = 0, B1 = 1, ..., H8 = 63.
+     * \param index The linear index of the square.
+     * \return The square.
+     * \throws OutOfRange If the index is outside the board.
+     */
+    static constexpr auto from_index(std::size_t index) -> Square {
+        return Square{File{static_cast<int>(index % File::max_file) + 1}, Rank{static_cast<int>(index / File::max_file) + 1}};
+    }
+
     /**
      * \brief Mirrors the rank at the center line.
      *
@@ -360,6 +374,92 @@ auto operator-(const Square &square, int squares) -> Square;
 
 auto to_string(const Square &square) -> std::string;
 
+/**
+ * \brief An optional square stored in a single byte.
+ *
+ * A Square carries its file, rank and index, which makes it convenient but
+ * large. PackedSquare only stores the index of the square, or a marker for "no
+ * square", so that it can be used in data structures that are copied often,
+ * such as the state of a position. It offers the parts of the std::optional
+ * interface that are needed to use it in place of a std::optional<Square>.
+ */
+class PackedSquare {
+public:
+    /**
+     * \brief Create an empty PackedSquare.
+     */
+    constexpr PackedSquare() = default;
+
+    /**
+     * \brief Create an empty PackedSquare.
+     */
+    constexpr PackedSquare(std::nullopt_t /*unused*/) {}
+
+    /**
+     * \brief Create a PackedSquare holding a square.
+     *
+     * \param square The square to store.
+     */
+    constexpr PackedSquare(const Square &square) : m_index{static_cast<std::uint8_t>(square.index())} {}
+
+    /**
+     * \brief Create a PackedSquare from an optional square.
+     *
+     * \param square The square to store, if any.
+     */
+    constexpr PackedSquare(const std::optional<Square> &square) : m_index{square.has_value() ? static_cast<std::uint8_t>(square->index()) : no_square} {}
+
+    /**
+     * \brief Check, if a square is stored.
+     *
+     * \return If a square is stored.
+     */
+    constexpr auto has_value() const -> bool { return m_index != no_square; }
+
+    /**
+     * \brief Access the stored square.
+     *
+     * \return The stored square.
+     * \throws std::bad_optional_access If no square is stored.
+     */
+    constexpr auto value() const -> Square {
+        if (!has_value()) {
+            throw std::bad_optional_access{};
+        }
+        return Square::from_index(m_index);
+    }
+
+    /**
+     * \brief Remove the stored square.
+     */
+    constexpr auto reset() -> void { m_index = no_square; }
+
+    /**
+     * \brief Convert into a std::optional.
+     *
+     * \return The stored square or an empty optional.
+     */
+    constexpr operator std::optional<Square>() const {
+        if (!has_value()) {
+            return std::nullopt;
+        }
+        return value();
+    }
+
+    /**
+     * \brief Comparison of two PackedSquares.
+     *
+     * \param lhs Left-hand side of the comparison.
+     * \param rhs Right-hand side of the comparison.
+     * \return If both are empty or hold the same square.
+     */
+    friend constexpr auto operator==(const PackedSquare &lhs, const PackedSquare &rhs) -> bool = default;
+private:
+    static constexpr std::uint8_t no_square{0xFF}; ///< Marker for "no square".
+
+    std::uint8_t m_index{no_square}; ///< The index of the square.
+};
+
 } // namespace chesscore
 
 #endif
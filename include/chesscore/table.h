@@ -54,6 +54,14 @@ public:
         static_assert(sizeof...(data) == Size, "Wrong number of elements");
     }
 
+    /**
+     * \brief Create a table from an array of entries.
+     *
+     * Allows filling tables by constexpr generator functions.
+     * \param data The entries.
+     */
+    constexpr explicit Table(const std::array<ElementT, Size> &data) : m_data{data} {}
+
     /**
      * \brief The number of elements in the table.
      *
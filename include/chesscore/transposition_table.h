@@ -0,0 +1,233 @@
+/* ************************************************************************** *
+ * Chess Core                                                                 *
+ * Data structures and algorithms for chess                                   *
+ * ************************************************************************** */
+/** \file */
+
+#ifndef CHESSCORE_TRANSPOSITION_TABLE_H
+#define CHESSCORE_TRANSPOSITION_TABLE_H
+
+#include "chesscore/huge_page_memory.h"
+#include "chesscore/move.h"
+#include "chesscore/zobrist.h"
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <type_traits>
+
+namespace chesscore {
+
+/**
+ * \brief Kind of bound a stored score represents.
+ */
+enum class Bound : std::uint8_t {
+    None,  ///< No score is stored.
+    Upper, ///< The score is an upper bound (fail low).
+    Lower, ///< The score is a lower bound (fail high).
+    Exact, ///< The score is exact.
+};
+
+/**
+ * \brief The data stored for a position in a transposition table.
+ */
+struct TranspositionData {
+    PackedMove move{};         ///< Best move found in the position.
+    std::int16_t score{0};     ///< Score of the position.
+    std::int16_t eval{0};      ///< Static evaluation of the position.
+    std::int8_t depth{0};      ///< Depth the score was searched with.
+    Bound bound{Bound::None};  ///< Kind of bound the score represents.
+
+    /**
+     * \brief Comparison of stored data.
+     *
+     * \param lhs Left-hand side of the comparison.
+     * \param rhs Right-hand side of the comparison.
+     * \return If both contain the same data.
+     */
+    friend constexpr auto operator==(const TranspositionData &lhs, const TranspositionData &rhs) -> bool = default;
+};
+
+/**
+ * \brief A hash table for search results, keyed by the Zobrist hash.
+ *
+ * The table is divided into buckets of the size of a cache line, so that a
+ * probe touches a single cache line. Each bucket holds a few entries, each
+ * made of two 64 bit words: the packed data and the hash key XORed with the
+ * data. Entries are read and written with relaxed atomic operations and no
+ * locks. If two threads write an entry at the same time, or a read interleaves
+ * with a write, the words do not fit together and the key check fails, so torn
+ * entries are treated as misses instead of returning wrong data.
+ *
+ * Unlike tables that store a 16 bit fragment of the key in 10 byte entries,
+ * the check word holds the complete key. An entry has to consist of whole 64
+ * bit words to be read and written atomically, and the data already fills one
+ * of them, so the full key costs no extra space. It also avoids the false hits
+ * of a key fragment, which occur once in 65536 probes of an occupied entry.
+ *
+ * Each store is tagged with the current generation, which is advanced with
+ * new_search(). When a bucket is full, the entry with the smallest depth is
+ * replaced, where entries of older generations count as shallower.
+ *
+ * The storage prefers huge pages (see HugePageMemory), since probes access
+ * the table randomly.
+ *
+ * Probing and storing are safe from any number of threads. Resizing and
+ * clearing the table are not, and must not happen while other threads access
+ * the table.
+ */
+class TranspositionTable {
+public:
+    static constexpr std::size_t entries_per_bucket{4}; ///< Number of entries in one bucket.
+
+    /**
+     * \brief Create an empty table without any storage.
+     */
+    TranspositionTable() = default;
+
+    /**
+     * \brief Create a table of a given size.
+     *
+     * \param megabytes Maximum size of the table in megabytes.
+     */
+    explicit TranspositionTable(std::size_t megabytes) { resize(megabytes); }
+
+    TranspositionTable(const TranspositionTable &) = delete;
+    auto operator=(const TranspositionTable &) -> TranspositionTable & = delete;
+
+    /**
+     * \brief Take over the storage of another table.
+     *
+     * \param other The table to move from; it is empty afterwards.
+     */
+    TranspositionTable(TranspositionTable &&other) noexcept;
+
+    /**
+     * \brief Take over the storage of another table.
+     *
+     * The storage held before is released.
+     * \param other The table to move from; it is empty afterwards.
+     * \return This table.
+     */
+    auto operator=(TranspositionTable &&other) noexcept -> TranspositionTable &;
+
+    ~TranspositionTable() = default;
+
+    /**
+     * \brief Change the size of the table.
+     *
+     * The number of buckets is the largest power of two that fits into the
+     * given size. All stored data is lost.
+     * \param megabytes Maximum size of the table in megabytes.
+     */
+    auto resize(std::size_t megabytes) -> void;
+
+    /**
+     * \brief Remove all entries from the table.
+     */
+    auto clear() -> void;
+
+    /**
+     * \brief Start a new generation of entries.
+     *
+     * Should be called before each new search, so that entries of earlier
+     * searches are preferred for replacement.
+     */
+    auto new_search() -> void { m_generation = static_cast<std::uint8_t>((m_generation + 1U) & generation_mask); }
+
+    /**
+     * \brief The current generation.
+     *
+     * \return The generation stored with new entries.
+     */
+    auto generation() const -> std::uint8_t { return m_generation; }
+
+    /**
+     * \brief Look up the data stored for a position.
+     *
+     * \param hash Hash of the position.
+     * \return The stored data, if the position is found.
+     */
+    auto probe(const ZobristHash &hash) const -> std::optional<TranspositionData>;
+
+    /**
+     * \brief Store data for a position.
+     *
+     * An existing entry of the same position is only overwritten by a search
+     * of similar or greater depth, by an exact score, or if it stems from an
+     * earlier generation. Its move is kept, if the new data has no move.
+     * \param hash Hash of the position.
+     * \param data The data to store.
+     */
+    auto store(const ZobristHash &hash, const TranspositionData &data) -> void;
+
+    /**
+     * \brief Prefetch the bucket of a position into the cache.
+     *
+     * Used with Position::key_after() to load the bucket of a child position
+     * before the move is made.
+     * \param hash Hash of the position.
+     */
+    auto prefetch(const ZobristHash &hash) const -> void;
+
+    /**
+     * \brief Estimate the fill level of the table.
+     *
+     * Samples the first buckets for entries of the current generation.
+     * \return The fill level in permille.
+     */
+    auto hashfull() const -> int;
+
+    /**
+     * \brief Number of buckets in the table.
+     *
+     * \return The number of buckets.
+     */
+    auto bucket_count() const -> std::size_t { return m_bucket_count; }
+
+    /**
+     * \brief Number of entries in the table.
+     *
+     * \return The number of entries.
+     */
+    auto entry_count() const -> std::size_t { return m_bucket_count * entries_per_bucket; }
+
+    /**
+     * \brief Check, if the table is backed by huge pages.
+     *
+     * \return If huge pages were obtained for the table.
+     */
+    auto huge_pages() const -> bool { return m_memory.huge_pages(); }
+private:
+    static constexpr unsigned generation_mask{0x3FU};
+    static constexpr int generation_cycle{generation_mask + 1U};
+
+    struct Entry {
+        std::atomic<std::uint64_t> key{0};
+        std::atomic<std::uint64_t> data{0};
+    };
+
+    struct alignas(64) Bucket {
+        std::array<Entry, entries_per_bucket> entries;
+    };
+    static_assert(sizeof(Bucket) == 64);
+    static_assert(std::is_aggregate_v<Bucket>);
+
+    static auto pack(const TranspositionData &data, std::uint8_t generation) -> std::uint64_t;
+    static auto unpack(std::uint64_t data) -> TranspositionData;
+    static auto generation_of(std::uint64_t data) -> std::uint8_t;
+
+    auto bucket(const ZobristHash &hash) const -> Bucket & { return m_buckets[hash.hash() & (m_bucket_count - 1)]; }
+    auto age(std::uint64_t data) const -> int;
+
+    HugePageMemory m_memory{};
+    Bucket *m_buckets{nullptr};
+    std::size_t m_bucket_count{0};
+    std::uint8_t m_generation{0};
+};
+
+} // namespace chesscore
+
+#endif
@@ -13,70 +13,110 @@
 
 #include <array>
 #include <cstdint>
-#include <optional>
-#include <random>
 
 namespace chesscore {
 
 class Position;
 
+namespace detail {
+
+/**
+ * \brief A constexpr pseudo random number generator.
+ *
+ * Implements the SplitMix64 generator, so that the Zobrist keys can be
+ * generated at compile time.
+ * \param state State of the generator, advanced by each call.
+ * \return The next pseudo random number.
+ */
+constexpr auto splitmix64(std::uint64_t &state) -> std::uint64_t {
+    state += 0x9E3779B97F4A7C15ULL;
+    std::uint64_t value = state;
+    value = (value ^ (value >> 30U)) * 0xBF58476D1CE4E5B9ULL;
+    value = (value ^ (value >> 27U)) * 0x94D049BB133111EBULL;
+    return value ^ (value >> 31U);
+}
+
+/**
+ * \brief Generate a sequence of non-zero pseudo random keys.
+ *
+ * \tparam Count Number of keys to generate.
+ * \param seed Seed of the random number generator.
+ * \return The generated keys.
+ */
+template<std::size_t Count>
+constexpr auto generate_zobrist_keys(std::uint64_t seed) -> std::array<std::uint64_t, Count> {
+    std::array<std::uint64_t, Count> keys{};
+    for (auto &key : keys) {
+        do {
+            key = splitmix64(seed);
+        } while (key == 0);
+    }
+    return keys;
+}
+
+inline constexpr std::size_t zobrist_piece_key_count{2 * piece_type_count * Square::count};
+inline constexpr std::size_t zobrist_castling_key_count{CastlingRights::count};
+inline constexpr std::size_t zobrist_enpassant_key_count{File::max_file};
+inline constexpr std::size_t zobrist_key_count{zobrist_piece_key_count + zobrist_castling_key_count + zobrist_enpassant_key_count + 1};
+
+inline constexpr std::uint64_t zobrist_seed{3275739884ULL};
+inline constexpr auto zobrist_key_stream = generate_zobrist_keys<zobrist_key_count>(zobrist_seed);
+
+template<std::size_t Offset, std::size_t Count>
+constexpr auto zobrist_key_slice() -> std::array<std::uint64_t, Count> {
+    std::array<std::uint64_t, Count> keys{};
+    for (std::size_t i = 0; i < Count; ++i) {
+        keys[i] = zobrist_key_stream[Offset + i];
+    }
+    return keys;
+}
+
+} // namespace detail
+
+/**
+ * \brief The random keys used for Zobrist hashing.
+ *
+ * All keys are generated at compile time. They are constant and can be used
+ * concurrently from any number of threads without synchronization.
+ */
+namespace zobrist_keys {
+
+inline constexpr auto piece_keys = detail::zobrist_key_slice<0, detail::zobrist_piece_key_count>();
+inline constexpr auto castling_keys = detail::zobrist_key_slice<detail::zobrist_piece_key_count, detail::zobrist_castling_key_count>();
+inline constexpr auto enpassant_keys =
+    detail::zobrist_key_slice<detail::zobrist_piece_key_count + detail::zobrist_castling_key_count, detail::zobrist_enpassant_key_count>();
+inline constexpr std::uint64_t side_key = detail::zobrist_key_stream[detail::zobrist_key_count - 1]; ///< Black to move.
+
+} // namespace zobrist_keys
+
 class ZobristKeys {
 public:
     using key_t = std::uint64_t;
-    static constexpr std::mt19937_64::result_type RandSeed{3275739884ULL};
-
-    static auto initialize() -> void {
-        if (m_initialized) {
-            return;
-        }
-        std::mt19937_64 rng{RandSeed};
-        std::uniform_int_distribution<key_t> dist;
-        for (size_t i = 0; i < m_piece_keys.size(); ++i) {
-            m_piece_keys[i] = generate_nonzero_key(rng, dist);
-        }
-        for (size_t i = 0; i < m_castling_keys.size(); ++i) {
-            m_castling_keys[i] = generate_nonzero_key(rng, dist);
-        }
-        for (size_t i = 0; i < m_enpassant_keys.size(); ++i) {
-            m_enpassant_keys[i] = generate_nonzero_key(rng, dist);
-        }
-        m_side_key = generate_nonzero_key(rng, dist);
-        m_initialized = true;
-    }
-
-    static auto initialized() -> bool { return m_initialized; }
 
-    static auto piece_key(Piece piece, Square square) -> key_t { return m_piece_keys[piece_index(piece, square)]; }
-    static auto piece_key(PieceType type, Color color, Square square) -> key_t { return piece_key(Piece{.type = type, .color = color}, square); }
-    static auto castling_key(CastlingRights rights) -> key_t { return m_castling_keys[castling_index(rights)]; }
-    static auto enpassant_key(File file) -> key_t { return m_enpassant_keys[static_cast<size_t>(file.file - File::min_file)]; }
-    static auto side_key() -> key_t { return m_side_key; }
+    static constexpr auto piece_key(Piece piece, Square square) -> key_t { return zobrist_keys::piece_keys[piece_index(piece, square)]; }
+    static constexpr auto piece_key(PieceType type, Color color, Square square) -> key_t { return piece_key(Piece{.type = type, .color = color}, square); }
+    static constexpr auto castling_key(CastlingRights rights) -> key_t { return zobrist_keys::castling_keys[rights.mask()]; }
+    static constexpr auto enpassant_key(File file) -> key_t { return zobrist_keys::enpassant_keys[static_cast<size_t>(file.file - File::min_file)]; }
+    static constexpr auto side_key() -> key_t { return zobrist_keys::side_key; }
+
+    /**
+     * \brief Key for the material signature.
+     *
+     * The material signature of a position is the combination of the keys for
+     * each piece and all counts below the number of those pieces on the board.
+     * The keys reuse the piece-square keys with the count taking the place of
+     * the square index.
+     * \param piece The piece.
+     * \param count The number of pieces of that kind before the piece is added.
+     * \return The key.
+     */
+    static constexpr auto material_key(Piece piece, int count) -> key_t { return zobrist_keys::piece_keys[piece_index(piece, static_cast<size_t>(count))]; }
 private:
-    static bool m_initialized;
-    static std::array<key_t, 2 * piece_type_count * Square::count> m_piece_keys;
-    static std::array<key_t, 16> m_castling_keys;
-    static std::array<key_t, Rank::max_rank> m_enpassant_keys;
-    static key_t m_side_key; // black to move
-
-    static auto generate_nonzero_key(std::mt19937_64 &rng, std::uniform_int_distribution<key_t> &dist) -> key_t {
-        key_t key = dist(rng);
-        while (key == 0) {
-            key = dist(rng);
-        }
-        return key;
-    }
+    static constexpr auto piece_index(Piece piece, Square square) -> size_t { return piece_index(piece, square.index()); }
 
-    static auto piece_index(Piece piece, Square square) -> size_t {
+    static constexpr auto piece_index(Piece piece, size_t square_index) -> size_t {
         size_t index = piece.color == Color::White ? 0 : piece_type_count * Square::count;
-        return index + get_index(piece.type) * Square::count + square.index();
-    }
-
-    static auto castling_index(CastlingRights rights) -> size_t {
-        size_t index = rights.black_queenside ? 1 : 0;
-        index += rights.black_kingside ? 2 : 0;
-        index += rights.white_queenside ? 4 : 0;
-        index += rights.white_kingside ? 8 : 0;
-        return index;
+        return index + get_index(piece.type) * Square::count + square_index;
     }
 };
 
@@ -84,13 +124,13 @@ class ZobristHash {
 public:
     using key_t = ZobristKeys::key_t;
 
-    ZobristHash() { ZobristKeys::initialize(); }
-    ZobristHash(key_t hash_value) : ZobristHash() { m_hash = hash_value; }
+    constexpr ZobristHash() = default;
+    constexpr ZobristHash(key_t hash_value) : m_hash{hash_value} {}
 
     static auto from_position(const Position &position) -> ZobristHash;
     static auto starting_position_hash() -> ZobristHash;
 
-    auto hash() const -> key_t { return m_hash; }
+    constexpr auto hash() const -> key_t { return m_hash; }
 
     auto set_piece(Piece piece, Square square) -> ZobristHash & {
         m_hash ^= ZobristKeys::piece_key(piece, square);
@@ -102,6 +142,10 @@ public:
         set_piece(piece, to);
         return *this;
     }
+    auto toggle_material(Piece piece, int count) -> ZobristHash & {
+        m_hash ^= ZobristKeys::material_key(piece, count);
+        return *this;
+    }
     auto swap_side() -> ZobristHash & {
         m_hash ^= ZobristKeys::side_key();
         return *this;
@@ -127,7 +171,6 @@ public:
     auto operator==(const ZobristHash &rhs) const -> bool { return m_hash == rhs.m_hash; }
 private:
     key_t m_hash{0};
-    static std::optional<key_t> m_starting_position_hash;
 };
 
 } // namespace chesscore
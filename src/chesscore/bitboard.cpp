@@ -10,8 +10,15 @@ namespace chesscore {
 
 namespace {
 
-auto step_pawns(const Bitmap &pawn, Color side_to_move) -> Bitmap {
-    return side_to_move == Color::White ? pawn << File::max_file : pawn >> File::max_file;
+using detail::ColorTraits;
+
+template<Color C>
+constexpr auto step_pawns(const Bitmap &pawns) -> Bitmap {
+    if constexpr (C == Color::White) {
+        return pawns << File::max_file;
+    } else {
+        return pawns >> File::max_file;
+    }
 }
 
 auto shift_left(const Bitmap &bitmap) -> Bitmap {
@@ -24,39 +31,59 @@ auto shift_right(const Bitmap &bitmap) -> Bitmap {
     return (bitmap & ~bitmaps::file_table[File::max_file]) << 1;
 }
 
-} // namespace
+constexpr std::array<RayDirection, 4> rook_directions{RayDirection::North, RayDirection::East, RayDirection::South, RayDirection::West};
+constexpr std::array<RayDirection, 4> bishop_directions{RayDirection::NorthEast, RayDirection::SouthEast, RayDirection::SouthWest, RayDirection::NorthWest};
 
-auto Bitboard::generate_pawn_move(
-    const Square &source, const Square &target, std::optional<Piece> captured, bool en_passant, std::optional<Piece> promoted, const PositionState &state, MoveList &moves
-) const -> void {
-    store_move_if_legal(
-        Move{
-            .from = source,
-            .to = target,
-            .piece = Piece{.type = PieceType::Pawn, .color = state.side_to_move},
-            .captured = captured,
-            .capturing_en_passant = en_passant,
-            .promoted = promoted,
-            .castling_rights_before = state.castling_rights,
-            .halfmove_clock_before = state.halfmove_clock,
-            .en_passant_target_before = state.en_passant_target
-        },
-        moves
-    );
-}
-
-auto Bitboard::generate_pawn_moves(const Square &source, const Square &target, std::optional<Piece> captured, bool en_passant, const PositionState &state, MoveList &moves) const
-    -> void {
-    if (target.rank().rank == Rank::min_rank || target.rank().rank == Rank::max_rank) {
-        const auto color = state.side_to_move;
-        for (const auto &type : all_promotion_piece_types) {
-            generate_pawn_move(source, target, captured, en_passant, Piece{.type = type, .color = color}, state, moves);
-        }
-    } else {
-        generate_pawn_move(source, target, captured, en_passant, std::nullopt, state, moves);
+auto nearest_square(const Bitmap &squares, RayDirection direction) -> Square {
+    return is_negative_direction(direction) ? squares.msb() : squares.lsb();
+}
+
+// squares reached along a ray up to and including the first occupied square
+auto ray_attacks(const Square &square, RayDirection direction, const Bitmap &occupancy) -> Bitmap {
+    auto targets = bitmaps::ray_target_table[direction][square];
+    const auto blockers = targets & occupancy;
+    if (!blockers.empty()) {
+        targets ^= bitmaps::ray_target_table[direction][nearest_square(blockers, direction)];
     }
+    return targets;
+}
+
+auto slider_attacks(const Square &square, const std::array<RayDirection, 4> &directions, const Bitmap &occupancy) -> Bitmap {
+    Bitmap targets{};
+    for (const auto direction : directions) {
+        targets |= ray_attacks(square, direction, occupancy);
+    }
+    return targets;
+}
+
+template<Color C>
+auto pawn_attack_span(const Bitmap &pawns) -> Bitmap {
+    const auto stepped_pawns = step_pawns<C>(pawns);
+    return shift_left(stepped_pawns) | shift_right(stepped_pawns);
+}
+
+template<Color C>
+auto pawn_targets_for(const Bitmap &pawns, const Bitmap &empty, const Bitmap &captureable_pieces) -> detail::PawnTargets {
+    const auto pawns_advance1 = step_pawns<C>(pawns);
+    const auto pawns_step1 = pawns_advance1 & empty;
+    // pawns have already advanced one step, therefore we use the rank in front of the double step rank
+    const auto double_step_mask = bitmaps::rank_table[Rank{ColorTraits<C>::double_step_rank + ColorTraits<C>::forward}];
+    const auto pawns_step2 = step_pawns<C>(pawns_step1 & double_step_mask) & empty;
+    return detail::PawnTargets{
+        .single_steps = pawns_step1,
+        .double_steps = pawns_step2,
+        .west_captures = shift_left(pawns_advance1) & captureable_pieces,
+        .east_captures = shift_right(pawns_advance1) & captureable_pieces,
+    };
+}
+
+// visitor that appends the generated moves to a list
+auto append_to(MoveList &moves) {
+    return [&moves](const Move &move) { moves.push_back(move); };
 }
 
+} // namespace
+
 Bitboard::Bitboard(const FenString &fen) {
     const auto &placements{fen.piece_placement()};
     for (int rank{Rank::min_rank}; rank <= Rank::max_rank; ++rank) {
@@ -71,11 +98,11 @@ Bitboard::Bitboard(const FenString &fen) {
 }
 
 auto Bitboard::empty() const -> bool {
-    return m_all_pieces.empty();
+    return occupied().empty();
 }
 
 auto Bitboard::has_piece(const PieceType &piece_type) const -> bool {
-    return !(bitmap({.type = piece_type, .color = Color::White}) | bitmap({.type = piece_type, .color = Color::Black})).empty();
+    return !bitmap(piece_type).empty();
 }
 
 auto Bitboard::has_piece(const Piece &piece) const -> bool {
@@ -87,25 +114,23 @@ auto Bitboard::has_piece(const Color &color) const -> bool {
 }
 
 auto Bitboard::has_piece(const Square &square) const -> bool {
-    return m_all_pieces.get(square);
+    return occupied().get(square);
 }
 
 auto Bitboard::set_piece(const Piece &piece, const Square &square) -> void {
     clear_square(square);
-    bitmap(piece).set(square);
-    m_all_pieces.set(square);
-    bitmap(piece.color).set(square);
+    m_piece_types[get_index(piece.type)].set(square);
+    m_colors[get_index(piece.color)].set(square);
 }
 
 auto Bitboard::get_piece(const Square &square) const -> std::optional<Piece> {
-    if (!m_all_pieces.get(square)) {
+    if (!occupied().get(square)) {
         return {};
     }
-    const auto [min_index, max_index] =
-        (m_white_pieces.get(square)) ? std::make_pair(min_white_piece_index, max_white_piece_index) : std::make_pair(min_black_piece_index, max_black_piece_index);
-    for (size_t i = min_index; i <= max_index; ++i) {
-        if (m_bitmaps.at(i).get(square)) {
-            return Piece{.type = static_cast<PieceType>(i - min_index), .color = (i <= max_white_piece_index) ? Color::White : Color::Black};
+    const auto color = bitmap(Color::White).get(square) ? Color::White : Color::Black;
+    for (const auto piece_type : all_piece_types) {
+        if (bitmap(piece_type).get(square)) {
+            return Piece{.type = piece_type, .color = color};
         }
     }
     return {};
@@ -114,187 +139,177 @@ auto Bitboard::get_piece(const Square &square) const -> std::optional<Piece> {
 auto Bitboard::clear_square(const Square &square) -> void {
     const auto remove_from_square = ~Bitmap{square};
 
-    for (auto &bitmap : m_bitmaps) {
+    for (auto &bitmap : m_piece_types) {
+        bitmap &= remove_from_square;
+    }
+    for (auto &bitmap : m_colors) {
         bitmap &= remove_from_square;
     }
-
-    m_white_pieces &= remove_from_square;
-    m_black_pieces &= remove_from_square;
-    m_all_pieces &= remove_from_square;
 }
 
 auto Bitboard::piece_count(Piece piece) const -> int {
     return bitmap(piece).count();
 }
 
+auto Bitboard::toggle_piece(const Piece &piece, const Bitmap &squares) -> void {
+    m_piece_types[get_index(piece.type)] ^= squares;
+    m_colors[get_index(piece.color)] ^= squares;
+}
+
 auto Bitboard::make_move(const Move &move) -> void {
-    clear_square(move.from);
+    const Bitmap from{move.from};
+    const Bitmap to{move.to};
+    if (move.capturing_en_passant) {
+        toggle_piece(move.captured.value(), Bitmap{Square{move.to.file(), move.from.rank()}});
+    } else if (move.captured) {
+        toggle_piece(move.captured.value(), to);
+    }
     if (move.promoted) {
-        set_piece(move.promoted.value(), move.to);
+        toggle_piece(move.piece, from);
+        toggle_piece(move.promoted.value(), to);
     } else {
-        set_piece(move.piece, move.to);
+        toggle_piece(move.piece, from | to);
     }
     if (move.is_castling()) {
-        move_castling_rook(move);
-    }
-    if (move.capturing_en_passant) {
-        clear_square(Square{move.to.file(), move.from.rank()});
-    }
-}
-
-void Bitboard::move_castling_rook(const Move &move) {
-    if (move.from.file().file < move.to.file().file) {
-        // Kingside castling
-        clear_square(Square{File{'H'}, move.to.rank()});                                                         // remove rook
-        set_piece(Piece{.type = PieceType::Rook, .color = move.piece.color}, Square{File{'F'}, move.to.rank()}); // place rook on f-file
-    } else {
-        // Queenside castling
-        clear_square(Square{File{'A'}, move.to.rank()});                                                         // remove rook
-        set_piece(Piece{.type = PieceType::Rook, .color = move.piece.color}, Square{File{'D'}, move.to.rank()}); // place rook on d-file
+        toggle_castling_rook(move);
     }
 }
 
 auto Bitboard::unmake_move(const Move &move) -> void {
-    set_piece(move.piece, move.from);
-    if (move.captured) {
-        if (move.capturing_en_passant) {
-            set_piece(move.captured.value(), Square{move.to.file(), move.from.rank()});
-            clear_square(move.to);
-        } else {
-            set_piece(move.captured.value(), move.to);
-        }
+    const Bitmap from{move.from};
+    const Bitmap to{move.to};
+    if (move.promoted) {
+        toggle_piece(move.promoted.value(), to);
+        toggle_piece(move.piece, from);
     } else {
-        clear_square(move.to);
+        toggle_piece(move.piece, from | to);
+    }
+    if (move.capturing_en_passant) {
+        toggle_piece(move.captured.value(), Bitmap{Square{move.to.file(), move.from.rank()}});
+    } else if (move.captured) {
+        toggle_piece(move.captured.value(), to);
     }
     if (move.is_castling()) {
-        reset_castling_rook(move);
+        toggle_castling_rook(move);
     }
 }
 
-auto Bitboard::reset_castling_rook(const Move &move) -> void {
+auto Bitboard::toggle_castling_rook(const Move &move) -> void {
+    const auto rank = move.from.rank();
+    const Piece rook{.type = PieceType::Rook, .color = move.piece.color};
     if (move.from.file().file < move.to.file().file) {
-        // Kingside castling
-        clear_square(Square{File{'F'}, move.from.rank()});                                                         // remove rook
-        set_piece(Piece{.type = PieceType::Rook, .color = move.piece.color}, Square{File{'H'}, move.from.rank()}); // place rook on h-file
+        // Kingside castling: rook between h-file and f-file
+        toggle_piece(rook, Bitmap{Square{File{'H'}, rank}} | Bitmap{Square{File{'F'}, rank}});
     } else {
-        // Queenside castling
-        clear_square(Square{File{'D'}, move.from.rank()});                                                         // remove rook
-        set_piece(Piece{.type = PieceType::Rook, .color = move.piece.color}, Square{File{'A'}, move.from.rank()}); // place rook on a-file
+        // Queenside castling: rook between a-file and d-file
+        toggle_piece(rook, Bitmap{Square{File{'A'}, rank}} | Bitmap{Square{File{'D'}, rank}});
     }
 }
 
 auto Bitboard::all_legal_moves(const PositionState &state) const -> MoveList {
     MoveList moves{};
-    all_knight_moves(moves, state);
-    all_king_moves(moves, state);
-    all_sliding_moves(moves, state);
-    all_pawn_moves(moves, state);
+    auto append = append_to(moves);
+    legal_moves<GenerationMode::Legal>(state, append);
+    return moves;
+}
+
+auto Bitboard::all_pseudo_legal_moves(const PositionState &state) const -> MoveList {
+    MoveList moves{};
+    auto append = append_to(moves);
+    legal_moves<GenerationMode::PseudoLegal>(state, append);
     return moves;
 }
 
+auto Bitboard::has_legal_move(const PositionState &state) const -> bool {
+    // the generators return false, as soon as this visitor stopped them at the first move
+    const auto stop = [](const Move &) { return false; };
+    if (!stepping_moves<GenerationMode::Legal>(PieceType::King, state, stop)) {
+        return true;
+    }
+    if (state.has_check_info() && state.checkers.count() > 1) {
+        return false;
+    }
+    if (state.has_check_info() && !state.checkers.empty()) {
+        const auto checker = state.checkers.lsb();
+        for (const auto type : {PieceType::Knight, PieceType::Bishop, PieceType::Rook, PieceType::Queen}) {
+            const Piece piece{.type = type, .color = state.side_to_move};
+            for (const auto defender : attackers_to(checker) & bitmap(piece)) {
+                if (!extract_moves<GenerationMode::Legal>(Bitmap{checker}, defender, piece, state, stop)) {
+                    return true;
+                }
+            }
+        }
+    }
+    if (!stepping_moves<GenerationMode::Legal>(PieceType::Knight, state, stop) || !sliding_moves<GenerationMode::Legal>(state, stop)) {
+        return true;
+    }
+    if (state.side_to_move == Color::White) {
+        return !pawn_moves<GenerationMode::Legal, Color::White>(state, stop);
+    }
+    return !pawn_moves<GenerationMode::Legal, Color::Black>(state, stop);
+}
+
 auto Bitboard::capture_moves(const PositionState &state) const -> MoveList {
     MoveList moves = all_legal_moves(state);
     moves.erase(std::remove_if(moves.begin(), moves.end(), [](const Move &move) { return !move.captured.has_value(); }), moves.end());
     return moves;
 }
 
-auto Bitboard::all_stepping_moves(PieceType piece_type, MoveList &moves, const PositionState &state) const -> void {
-    const auto piece = Piece{.type = piece_type, .color = state.side_to_move};
-    Bitmap pieces{bitmap(piece)};
-
-    Square pos{Square::A1};
-    while (!pieces.empty()) {
-        const auto shift = pieces.empty_squares_before();
-        pos += shift;
-        pieces >>= shift;
-
-        auto targets = bitmaps::get_target_table(piece_type)[pos] & ~bitmap(state.side_to_move);
-        extract_moves(targets, pos, piece, state, moves);
-
-        pos += 1;
-        pieces >>= 1;
-    }
+auto Bitboard::stepping_targets(PieceType piece_type, const Square &square, Color moving_color) const -> Bitmap {
+    return bitmaps::get_target_table(piece_type)[square] & ~bitmap(moving_color);
 }
 
 auto Bitboard::all_knight_moves(MoveList &moves, const PositionState &state) const -> void {
-    all_stepping_moves(PieceType::Knight, moves, state);
+    auto append = append_to(moves);
+    stepping_moves<GenerationMode::Legal>(PieceType::Knight, state, append);
 }
 
 auto Bitboard::all_king_moves(MoveList &moves, const PositionState &state) const -> void {
-    all_stepping_moves(PieceType::King, moves, state);
-    generate_castling_moves(moves, state);
+    auto append = append_to(moves);
+    stepping_moves<GenerationMode::Legal>(PieceType::King, state, append);
+    if (state.side_to_move == Color::White) {
+        generate_castling_moves<Color::White>(state, append);
+    } else {
+        generate_castling_moves<Color::Black>(state, append);
+    }
 }
 
 auto Bitboard::all_sliding_moves(MoveList &moves, const PositionState &state) const -> void {
-    sliding_moves_for_type(PieceType::Queen, moves, state);
-    sliding_moves_for_type(PieceType::Bishop, moves, state);
-    sliding_moves_for_type(PieceType::Rook, moves, state);
-}
-
-auto Bitboard::sliding_moves_for_type(PieceType piece_type, MoveList &moves, const PositionState &state) const -> void {
-    const auto piece = Piece{.type = piece_type, .color = state.side_to_move};
-    auto squares = bitmap(piece);
-    Square square{Square::A1};
-    while (!squares.empty()) {
-        const auto shift = squares.empty_squares_before();
-        square += shift;
-        squares >>= shift;
-        all_sliding_moves(piece, square, moves, state);
-        square += 1;
-        squares >>= 1;
-    }
+    auto append = append_to(moves);
+    sliding_moves<GenerationMode::Legal>(state, append);
 }
 
 auto Bitboard::all_sliding_moves(const Piece &moving_piece, const Square &start, MoveList &moves, const PositionState &state) const -> void {
-    const auto ray_directions_for_piece = piece_ray_directions[moving_piece.type];
-    for (auto direction : all_ray_directions) {
-        if (ray_directions_for_piece & direction) {
-            all_moves_along_ray(moving_piece, start, direction, moves, state);
-        }
-    }
+    auto append = append_to(moves);
+    sliding_piece_moves<GenerationMode::Legal>(moving_piece, start, state, append);
 }
 
 auto Bitboard::all_targets_along_ray(const Square &start, Color moving_color, const RayDirection &direction) const -> Bitmap {
-    auto targets = bitmaps::ray_target_table[direction][start];
-    const auto blockers = targets & m_all_pieces;
-    if (!blockers.empty()) {
-        const auto blocker_square = Square::A1 + (is_negative_direction(direction) ? 63 - blockers.empty_squares_after() : blockers.empty_squares_before());
-        targets ^= bitmaps::ray_target_table[direction][blocker_square];
-    }
-    targets &= ~bitmap(moving_color);
-    return targets;
+    return ray_attacks(start, direction, occupied()) & ~bitmap(moving_color);
 }
 
 auto Bitboard::all_moves_along_ray(const Piece &moving_piece, const Square &start, const RayDirection &direction, MoveList &moves, const PositionState &state) const -> void {
-    const auto targets = all_targets_along_ray(start, state.side_to_move, direction);
-    extract_moves(targets, start, moving_piece, state, moves);
+    auto append = append_to(moves);
+    extract_moves<GenerationMode::Legal>(all_targets_along_ray(start, state.side_to_move, direction), start, moving_piece, state, append);
 }
 
-auto Bitboard::remove_occupied_squares(const Bitmap &bitmap) const -> Bitmap {
-    return bitmap & ~m_all_pieces;
+auto Bitboard::all_pawn_moves(MoveList &moves, const PositionState &state) const -> void {
+    auto append = append_to(moves);
+    if (state.side_to_move == Color::White) {
+        pawn_moves<GenerationMode::Legal, Color::White>(state, append);
+    } else {
+        pawn_moves<GenerationMode::Legal, Color::Black>(state, append);
+    }
 }
 
-auto Bitboard::all_pawn_moves(MoveList &moves, const PositionState &state) const -> void {
+auto Bitboard::pawn_targets(const PositionState &state) const -> detail::PawnTargets {
+    const auto opponent = other_color(state.side_to_move);
+    const auto captureable_pieces = state.en_passant_target.has_value() ? bitmap(opponent) | Bitmap{state.en_passant_target.value()} : bitmap(opponent);
     const auto pawns = bitmap(Piece{.type = PieceType::Pawn, .color = state.side_to_move});
-    const auto pawns_advance1 = step_pawns(pawns, state.side_to_move);
-    const auto pawns_step1 = remove_occupied_squares(pawns_advance1);
-    extract_pawn_moves(pawns_step1, 1, state, moves);
-
-    const auto double_step_mask = // pawns have already advanced one step, therefore we use the incremented/decremented ranks here
-        state.side_to_move == Color::White ? bitmaps::rank_table[Rank{Rank::white_pawn_double_step_rank + 1}] : bitmaps::rank_table[Rank{Rank::black_pawn_double_step_rank - 1}];
-    const auto pawns_double_candidates = pawns_step1 & double_step_mask;
-    const auto pawns_advance2 = step_pawns(pawns_double_candidates, state.side_to_move);
-    const auto pawns_step2 = remove_occupied_squares(pawns_advance2);
-    extract_pawn_moves(pawns_step2, 2, state, moves);
-
-    const auto captureable_pieces =
-        state.en_passant_target.has_value() ? bitmap(other_color(state.side_to_move)) | Bitmap{state.en_passant_target.value()} : bitmap(other_color(state.side_to_move));
-    const auto pawns_W = shift_left(pawns_advance1);
-    const auto pawns_capture_W = pawns_W & captureable_pieces;
-    extract_pawn_captures(pawns_capture_W, PawnCaptureDirection::West, state, moves);
-    const auto pawns_E = shift_right(pawns_advance1);
-    const auto pawns_capture_E = pawns_E & captureable_pieces;
-    extract_pawn_captures(pawns_capture_E, PawnCaptureDirection::East, state, moves);
+    if (state.side_to_move == Color::White) {
+        return pawn_targets_for<Color::White>(pawns, ~occupied(), captureable_pieces);
+    }
+    return pawn_targets_for<Color::Black>(pawns, ~occupied(), captureable_pieces);
 }
 
 auto Bitboard::is_attacked(const Square &square, Color attacker_color) const -> bool {
@@ -308,10 +323,12 @@ auto Bitboard::would_be_attacked(const Square &square, Color attacker_color, con
 }
 
 auto Bitboard::pawn_attacks(const Square &square, Color pawn_color) const -> bool {
-    const auto pawns = bitmap(Piece{.type = PieceType::Pawn, .color = pawn_color});
-    const auto stepped_pawns = step_pawns(pawns, pawn_color);
-    const auto attacked_squares = shift_left(stepped_pawns) | shift_right(stepped_pawns);
-    return attacked_squares.get(square);
+    return pawn_color == Color::White ? pawn_attacks<Color::White>(square) : pawn_attacks<Color::Black>(square);
+}
+
+template<Color C>
+auto Bitboard::pawn_attacks(const Square &square) const -> bool {
+    return pawn_attack_span<C>(bitmap(Piece{.type = PieceType::Pawn, .color = C})).get(square);
 }
 
 auto Bitboard::knight_attacks(const Square &square, Color knight_color) const -> bool {
@@ -343,155 +360,319 @@ auto Bitboard::sliding_piece_attacks(const Square &square, Color piece_color) co
            attacked_from_ray(square, piece_color, RayDirection::NorthWest, PieceType::Bishop, PieceType::Queen);
 }
 
-auto Bitboard::extract_moves(Bitmap targets, const Square &from, const Piece &piece, const PositionState &state, MoveList &moves) const -> void {
-    Square target_square{Square::A1};
-    while (!targets.empty()) {
-        const auto shift = targets.empty_squares_before();
-        target_square += shift;
-        targets >>= shift;
-        store_move_if_legal(
-            Move{
-                .from = from,
-                .to = target_square,
-                .piece = piece,
-                .captured = get_piece(target_square),
-                .capturing_en_passant = false,
-                .promoted = {},
-                .castling_rights_before = state.castling_rights,
-                .halfmove_clock_before = state.halfmove_clock,
-                .en_passant_target_before = state.en_passant_target
-            },
-            moves
-        );
-        target_square += 1;
-        targets >>= 1;
-    }
-}
-
-auto Bitboard::extract_pawn_moves(Bitmap targets, int step_size, const PositionState &state, MoveList &moves) const -> void {
-    Square target_square{Square::A1};
-    while (!targets.empty()) {
-        const auto shift = targets.empty_squares_before();
-        target_square += shift;
-        targets >>= shift;
-        const auto source_square = state.side_to_move == Color::White ? (target_square - File::max_file * step_size) : (target_square + File::max_file * step_size);
-        generate_pawn_moves(source_square, target_square, std::nullopt, false, state, moves);
-        target_square += 1;
-        targets >>= 1;
-    }
-}
-
-auto Bitboard::extract_pawn_captures(Bitmap targets, PawnCaptureDirection direction, const PositionState &state, MoveList &moves) const -> void {
-    Square target_square{Square::A1};
-    while (!targets.empty()) {
-        const auto shift = targets.empty_squares_before();
-        target_square += shift;
-        targets >>= shift;
-        const auto source_square = Square{
-            File{direction == PawnCaptureDirection::East ? target_square.file().file - 1 : target_square.file().file + 1},
-            Rank{state.side_to_move == Color::White ? target_square.rank().rank - 1 : target_square.rank().rank + 1},
-        };
-        const auto captured = get_piece(target_square);
-        generate_pawn_moves(
-            source_square, target_square, captured.value_or(Piece{.type = PieceType::Pawn, .color = other_color(state.side_to_move)}), !captured.has_value(), state, moves
-        );
-        target_square += 1;
-        targets >>= 1;
-    }
-}
-
-auto Bitboard::generate_castling_moves(MoveList &moves, const PositionState &state) const -> void {
-    if (state.side_to_move == Color::White) {
-        if (state.castling_rights.white_kingside && !is_attacked(Square::E1, Color::Black) && !has_piece(Square::F1) && !is_attacked(Square::F1, Color::Black) &&
-            !has_piece(Square::G1) && !is_attacked(Square::G1, Color::Black)) {
-            moves.push_back(
-                Move{
-                    .from = Square::E1,
-                    .to = Square::G1,
-                    .piece = Piece{.type = PieceType::King, .color = Color::White},
-                    .captured = {},
-                    .capturing_en_passant = false,
-                    .promoted = {},
-                    .castling_rights_before = state.castling_rights,
-                    .halfmove_clock_before = state.halfmove_clock,
-                    .en_passant_target_before = state.en_passant_target
-                }
-            );
+auto Bitboard::attackers_to(const Square &square, const Bitmap &occupancy) const -> Bitmap {
+    // a pawn of one color attacks the square, if a pawn of the other color on the square would attack the pawn
+    auto attackers = bitmaps::pawn_attack_table[Color::Black][square] & bitmap(Piece{.type = PieceType::Pawn, .color = Color::White});
+    attackers |= bitmaps::pawn_attack_table[Color::White][square] & bitmap(Piece{.type = PieceType::Pawn, .color = Color::Black});
+    attackers |= bitmaps::knight_target_table[square] & bitmap(PieceType::Knight);
+    attackers |= bitmaps::king_target_table[square] & bitmap(PieceType::King);
+    const auto queens = bitmap(PieceType::Queen);
+    const auto rooks = (bitmap(PieceType::Rook) | queens) & bitmaps::rook_target_table[square];
+    const auto bishops = (bitmap(PieceType::Bishop) | queens) & bitmaps::bishop_target_table[square];
+    if (!rooks.empty()) {
+        attackers |= slider_attacks(square, rook_directions, occupancy) & rooks;
+    }
+    if (!bishops.empty()) {
+        attackers |= slider_attacks(square, bishop_directions, occupancy) & bishops;
+    }
+    return attackers;
+}
+
+auto Bitboard::attackers_of(const Square &square, Color attacker_color) const -> Bitmap {
+    return attackers_to(square) & bitmap(attacker_color);
+}
+
+auto Bitboard::snipers(const Square &square, Color slider_color) const -> Bitmap {
+    // sliding pieces that would attack the square on an empty board
+    const auto queens = bitmap(Piece{.type = PieceType::Queen, .color = slider_color});
+    const auto rooks = (bitmap(Piece{.type = PieceType::Rook, .color = slider_color}) | queens) & bitmaps::rook_target_table[square];
+    const auto bishops = (bitmap(Piece{.type = PieceType::Bishop, .color = slider_color}) | queens) & bitmaps::bishop_target_table[square];
+    return rooks | bishops;
+}
+
+auto Bitboard::attacks(const Piece &piece, const Square &square) const -> Bitmap {
+    return attacks(piece, square, occupied());
+}
+
+auto Bitboard::attacks(const Piece &piece, const Square &square, const Bitmap &occupancy) const -> Bitmap {
+    switch (piece.type) {
+    case PieceType::Pawn:
+        return bitmaps::pawn_attack_table[piece.color][square];
+    case PieceType::Knight:
+    case PieceType::King:
+        return bitmaps::get_target_table(piece.type)[square];
+    case PieceType::Rook:
+        return slider_attacks(square, rook_directions, occupancy);
+    case PieceType::Bishop:
+        return slider_attacks(square, bishop_directions, occupancy);
+    case PieceType::Queen:
+        return slider_attacks(square, rook_directions, occupancy) | slider_attacks(square, bishop_directions, occupancy);
+    }
+    return Bitmap{};
+}
+
+auto Bitboard::attacks_by(const Piece &piece) const -> Bitmap {
+    if (piece.type == PieceType::Pawn) {
+        // all pawns at once, by shifting the whole set
+        return piece.color == Color::White ? pawn_attack_span<Color::White>(bitmap(piece)) : pawn_attack_span<Color::Black>(bitmap(piece));
+    }
+    Bitmap targets{};
+    for (const auto square : bitmap(piece)) {
+        targets |= attacks(piece, square);
+    }
+    return targets;
+}
+
+auto Bitboard::attacks_by(Color color) const -> Bitmap {
+    Bitmap targets{};
+    for (const auto type : all_piece_types) {
+        targets |= attacks_by(Piece{.type = type, .color = color});
+    }
+    return targets;
+}
+
+auto Bitboard::mobility(const Piece &piece, const Bitmap &area) const -> int {
+    int count = 0;
+    for (const auto square : bitmap(piece)) {
+        count += (attacks(piece, square) & area).count();
+    }
+    return count;
+}
+
+auto Bitboard::slider_blockers(const Square &square, Color slider_color) const -> Bitmap {
+    Bitmap blockers{};
+    for (const auto sniper : snipers(square, slider_color)) {
+        const auto between = bitmaps::between(square, sniper) & occupied();
+        if (between.count() == 1) {
+            blockers |= between;
         }
-        if (state.castling_rights.white_queenside && !is_attacked(Square::E1, Color::Black) && !has_piece(Square::D1) && !is_attacked(Square::D1, Color::Black) &&
-            !has_piece(Square::C1) && !is_attacked(Square::C1, Color::Black) && !has_piece(Square::B1)) {
-            moves.push_back(
-                Move{
-                    .from = Square::E1,
-                    .to = Square::C1,
-                    .piece = Piece{.type = PieceType::King, .color = Color::White},
-                    .captured = {},
-                    .capturing_en_passant = false,
-                    .promoted = {},
-                    .castling_rights_before = state.castling_rights,
-                    .halfmove_clock_before = state.halfmove_clock,
-                    .en_passant_target_before = state.en_passant_target
-                }
-            );
+    }
+    return blockers;
+}
+
+auto Bitboard::pinned_pieces(const Square &king_square, Color color) const -> Bitmap {
+    return slider_blockers(king_square, other_color(color)) & bitmap(color);
+}
+
+auto Bitboard::pinners(const Square &king_square, Color color) const -> Bitmap {
+    Bitmap pinners{};
+    for (const auto sniper : snipers(king_square, other_color(color))) {
+        const auto between = bitmaps::between(king_square, sniper) & occupied();
+        if (between.count() == 1 && !(between & bitmap(color)).empty()) {
+            pinners.set(sniper);
         }
-    } else {
-        if (state.castling_rights.black_kingside && !is_attacked(Square::E8, Color::White) && !has_piece(Square::F8) && !is_attacked(Square::F8, Color::White) &&
-            !has_piece(Square::G8) && !is_attacked(Square::G8, Color::White)) {
-            moves.push_back(
-                Move{
-                    .from = Square::E8,
-                    .to = Square::G8,
-                    .piece = Piece{.type = PieceType::King, .color = Color::Black},
-                    .captured = {},
-                    .capturing_en_passant = false,
-                    .promoted = {},
-                    .castling_rights_before = state.castling_rights,
-                    .halfmove_clock_before = state.halfmove_clock,
-                    .en_passant_target_before = state.en_passant_target
-                }
-            );
+    }
+    return pinners;
+}
+
+auto Bitboard::discovered_check_candidates(Color color) const -> Bitmap {
+    const auto king_square = find_king(other_color(color));
+    if (!king_square.has_value()) {
+        return Bitmap{};
+    }
+    return slider_blockers(king_square.value(), color) & bitmap(color);
+}
+
+auto Bitboard::xray_attacks(const Square &square, PieceType slider_type, const Square &through) const -> Bitmap {
+    const auto attacks = [&](const Bitmap &occupancy) {
+        Bitmap targets{};
+        if (slider_type == PieceType::Rook || slider_type == PieceType::Queen) {
+            targets |= slider_attacks(square, rook_directions, occupancy);
         }
-        if (state.castling_rights.black_queenside && !is_attacked(Square::E8, Color::White) && !has_piece(Square::D8) && !is_attacked(Square::D8, Color::White) &&
-            !has_piece(Square::C8) && !is_attacked(Square::C8, Color::White) && !has_piece(Square::B8)) {
-            moves.push_back(
-                Move{
-                    .from = Square::E8,
-                    .to = Square::C8,
-                    .piece = Piece{.type = PieceType::King, .color = Color::Black},
-                    .captured = {},
-                    .capturing_en_passant = false,
-                    .promoted = {},
-                    .castling_rights_before = state.castling_rights,
-                    .halfmove_clock_before = state.halfmove_clock,
-                    .en_passant_target_before = state.en_passant_target
-                }
-            );
+        if (slider_type == PieceType::Bishop || slider_type == PieceType::Queen) {
+            targets |= slider_attacks(square, bishop_directions, occupancy);
         }
+        return targets;
+    };
+    auto transparent = occupied();
+    transparent.clear(through);
+    return attacks(transparent) & ~attacks(occupied());
+}
+
+auto Bitboard::update_check_info(PositionState &state) const -> void {
+    for (const auto color : {Color::White, Color::Black}) {
+        const auto index = get_index(color);
+        state.king_square[index] = find_king(color);
+        state.king_blockers[index] = state.king_square[index].has_value() ? slider_blockers(state.king_square[index].value(), other_color(color)) : Bitmap{};
+    }
+    const auto &king_square = state.king_square[get_index(state.side_to_move)];
+    state.checkers = king_square.has_value() ? attackers_of(king_square.value(), other_color(state.side_to_move)) : Bitmap{};
+    const auto &opponent_king = state.king_square[get_index(other_color(state.side_to_move))];
+    state.bishop_check_squares = opponent_king.has_value() ? slider_attacks(opponent_king.value(), bishop_directions, occupied()) : Bitmap{};
+    state.rook_check_squares = opponent_king.has_value() ? slider_attacks(opponent_king.value(), rook_directions, occupied()) : Bitmap{};
+}
+
+auto Bitboard::is_legal_move(const Move &move, const PositionState &state) const -> bool {
+    const Color color = move.piece.color;
+    if (!state.has_check_info() || color != state.side_to_move || move.capturing_en_passant) {
+        // en passant removes two pieces from a rank, which the cached pins do not cover
+        const auto king_square = move.piece.type == PieceType::King ? move.to : find_king(color);
+        if (king_square.has_value()) {
+            return !would_be_attacked(king_square.value(), other_color(color), move);
+        }
+        return true;
+    }
+    if (move.piece.type == PieceType::King) {
+        // the king must not stay on a line it shields from a slider
+        auto occupancy = occupied();
+        occupancy.clear(move.from);
+        return (attackers_to(move.to, occupancy) & bitmap(other_color(color))).empty();
     }
+    if (state.checkers.count() > 1) {
+        return false;
+    }
+    const auto &king_square = state.king_square[get_index(color)];
+    if (!king_square.has_value()) {
+        return true;
+    }
+    if (!state.checkers.empty()) {
+        // capture the checking piece or block its line
+        const auto checker = state.checkers.lsb();
+        if (move.to != checker && !bitmaps::between(king_square.value(), checker).get(move.to)) {
+            return false;
+        }
+    }
+    return !state.king_blockers[get_index(color)].get(move.from) || bitmaps::line(king_square.value(), move.from).get(move.to);
 }
 
-auto Bitboard::store_move_if_legal(const Move &move, MoveList &moves) const -> void {
-    Color color = move.piece.color;
-    const auto king_square = move.piece.type == PieceType::King ? move.to : find_king(color);
-    if (king_square.has_value()) {
-        if (would_be_attacked(king_square.value(), other_color(color), move)) {
-            return;
+auto Bitboard::is_pseudo_legal(const Move &move, const PositionState &state) const -> bool {
+    const auto color = state.side_to_move;
+    if (move.piece.color != color || get_piece(move.from) != move.piece || move.from == move.to) {
+        return false;
+    }
+    if (move.is_castling()) {
+        if (move.captured.has_value() || move.promoted.has_value() || move.capturing_en_passant) {
+            return false;
+        }
+        // the generation stops at the matching castling move
+        const auto other_target = [&move](const Move &castling) { return castling.to != move.to; };
+        if (color == Color::White) {
+            return !generate_castling_moves<Color::White>(state, other_target);
+        }
+        return !generate_castling_moves<Color::Black>(state, other_target);
+    }
+    const auto target = get_piece(move.to);
+    if (move.capturing_en_passant) {
+        return move.piece.type == PieceType::Pawn && state.en_passant_target.has_value() && state.en_passant_target.value() == move.to && !target.has_value() &&
+               move.captured == Piece{.type = PieceType::Pawn, .color = other_color(color)} && !move.promoted.has_value() &&
+               bitmaps::pawn_attack_table[color][move.from].get(move.to);
+    }
+    if (target != move.captured || (target.has_value() && (target->color == color || target->type == PieceType::King))) {
+        return false;
+    }
+    if (move.piece.type != PieceType::Pawn) {
+        return !move.promoted.has_value() && attacks(move.piece, move.from).get(move.to);
+    }
+    const bool white = color == Color::White;
+    const bool promotes = move.to.rank().rank == (white ? Rank::max_rank : Rank::min_rank);
+    if (promotes != move.promoted.has_value() ||
+        (promotes && (move.promoted->color != color || move.promoted->type == PieceType::Pawn || move.promoted->type == PieceType::King))) {
+        return false;
+    }
+    if (target.has_value()) {
+        return bitmaps::pawn_attack_table[color][move.from].get(move.to);
+    }
+    const int forward = white ? File::max_file : -File::max_file;
+    const int from_index = static_cast<int>(move.from.index());
+    const int to_index = static_cast<int>(move.to.index());
+    if (to_index == from_index + forward) {
+        return true;
+    }
+    const int double_step_rank = white ? Rank::white_pawn_double_step_rank : Rank::black_pawn_double_step_rank;
+    return move.from.rank().rank == double_step_rank && to_index == from_index + 2 * forward && !has_piece(Square::from_index(static_cast<std::size_t>(from_index + forward)));
+}
+
+auto Bitboard::gives_check(const Move &move, const PositionState &state) const -> bool {
+    const auto color = move.piece.color;
+    const PositionState *info = &state;
+    PositionState moving_state{};
+    if (!state.has_check_info() || color != state.side_to_move) {
+        // the cached information is missing or belongs to the other player
+        moving_state = state;
+        moving_state.side_to_move = color;
+        update_check_info(moving_state);
+        info = &moving_state;
+    }
+    const auto opponent_king = info->king_square[get_index(other_color(color))];
+    if (!opponent_king.has_value()) {
+        return false;
+    }
+    const auto &king_square = opponent_king.value();
+    if (!move.is_castling() && !move.capturing_en_passant) {
+        // discovered check by a piece leaving the line between a slider and the king
+        if (info->king_blockers[get_index(other_color(color))].get(move.from) && !bitmaps::line(king_square, move.from).get(move.to)) {
+            return true;
+        }
+        if (move.promoted.has_value()) {
+            // the vacated square may lie between the target square and the king
+            auto occupancy = occupied();
+            occupancy.clear(move.from);
+            return attacks(move.promoted.value(), move.to, occupancy).get(king_square);
         }
+        switch (move.piece.type) {
+        case PieceType::Pawn:
+            return bitmaps::pawn_attack_table[other_color(color)][king_square].get(move.to);
+        case PieceType::Knight:
+            return bitmaps::get_target_table(PieceType::Knight)[king_square].get(move.to);
+        case PieceType::Bishop:
+            return info->bishop_check_squares.get(move.to);
+        case PieceType::Rook:
+            return info->rook_check_squares.get(move.to);
+        case PieceType::Queen:
+            return (info->bishop_check_squares | info->rook_check_squares).get(move.to);
+        case PieceType::King:
+            return false;
+        }
+        return false;
+    }
+    // castling and en passant change more than two squares
+    auto occupancy = occupied();
+    occupancy.clear(move.from);
+    occupancy.set(move.to);
+    auto moved_from = Bitmap{move.from};
+    Piece checking_piece = move.promoted.value_or(move.piece);
+    Square checking_square = move.to;
+    if (move.is_castling()) {
+        // the rook may give check from its new square
+        const bool kingside = move.to.file().file > move.from.file().file;
+        const Square rook_from{File{kingside ? 'H' : 'A'}, move.from.rank()};
+        checking_piece = Piece{.type = PieceType::Rook, .color = color};
+        checking_square = Square{File{kingside ? 'F' : 'D'}, move.from.rank()};
+        occupancy.clear(rook_from);
+        occupancy.set(checking_square);
+        moved_from.set(rook_from);
+    } else if (move.capturing_en_passant) {
+        occupancy.clear(Square{move.to.file(), move.from.rank()});
+    }
+    if (attacks(checking_piece, checking_square, occupancy).get(king_square)) {
+        return true;
+    }
+    // discovered check by a slider that was blocked by a vacated square
+    if ((info->king_blockers[get_index(other_color(color))] & moved_from).empty() && !move.capturing_en_passant) {
+        return false;
     }
-    moves.push_back(move);
+    for (const auto sniper : snipers(king_square, color) & ~moved_from) {
+        if ((bitmaps::between(king_square, sniper) & occupancy).empty()) {
+            return true;
+        }
+    }
+    return false;
+}
+
+auto Bitboard::is_legal(const Move &move, const PositionState &state) const -> bool {
+    return is_pseudo_legal(move, state) && (move.is_castling() || is_legal_move(move, state));
 }
 
 auto Bitboard::find_king(Color color) const -> std::optional<Square> {
     const auto map = bitmap(Piece{.type = PieceType::King, .color = color});
     if (!map.empty()) {
-        const auto shift = map.empty_squares_before();
-        return Square{Square::A1 + shift};
+        return map.lsb();
     }
     return {};
 }
 
 auto Bitboard::operator==(const Bitboard &rhs) const -> bool {
-    return m_bitmaps == rhs.m_bitmaps;
+    return m_piece_types == rhs.m_piece_types && m_colors == rhs.m_colors;
 }
 
 } // namespace chesscore
@@ -176,16 +176,16 @@ auto check_castling_availability(const std::string &fen_string, std::size_t pos)
     for (size_t i = 0; i < castling_string.length(); ++i) {
         switch (castling_string[i]) {
         case 'K':
-            ability.white_kingside = true;
+            ability.set(CastlingRights::WhiteKingside);
             break;
         case 'Q':
-            ability.white_queenside = true;
+            ability.set(CastlingRights::WhiteQueenside);
             break;
         case 'k':
-            ability.black_kingside = true;
+            ability.set(CastlingRights::BlackKingside);
             break;
         case 'q':
-            ability.black_queenside = true;
+            ability.set(CastlingRights::BlackQueenside);
             break;
         default:
             break;
@@ -275,16 +275,16 @@ auto placement_to_string(const PiecePlacement &placement) -> std::string {
 
 auto castling_rights_to_string(const CastlingRights &castling_rights) -> std::string {
     std::string result;
-    if (castling_rights.white_kingside) {
+    if (castling_rights.white_kingside()) {
         result += 'K';
     }
-    if (castling_rights.white_queenside) {
+    if (castling_rights.white_queenside()) {
         result += 'Q';
     }
-    if (castling_rights.black_kingside) {
+    if (castling_rights.black_kingside()) {
         result += 'k';
     }
-    if (castling_rights.black_queenside) {
+    if (castling_rights.black_queenside()) {
         result += 'q';
     }
     if (result.empty()) {
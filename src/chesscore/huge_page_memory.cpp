@@ -0,0 +1,170 @@
+/* ************************************************************************** *
+ * Chess Core                                                                 *
+ * Data structures and algorithms for chess                                   *
+ * ************************************************************************** */
+
+#include "chesscore/huge_page_memory.h"
+
+#include <cstring>
+#include <new>
+#include <utility>
+
+#if defined(__linux__)
+#include <charconv>
+#include <cstdint>
+#include <fstream>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <sys/mman.h>
+#endif
+
+namespace chesscore {
+
+namespace {
+
+#if defined(__linux__)
+
+// parses a hexadecimal address of a mapping
+auto parse_address(const char *first, const char *last) -> std::optional<std::uintptr_t> {
+    std::uintptr_t address{0};
+    const auto [end, error] = std::from_chars(first, last, address, 16);
+    if (error != std::errc{} || end != last) {
+        return std::nullopt;
+    }
+    return address;
+}
+
+// number of bytes in [begin, begin + size) the kernel backs with transparent huge pages
+auto transparent_huge_page_bytes(const void *begin, std::size_t size) -> std::size_t {
+    const auto range_begin = reinterpret_cast<std::uintptr_t>(begin);
+    const auto range_end = range_begin + size;
+    std::ifstream smaps{"/proc/self/smaps"};
+    std::string line;
+    bool in_range{false};
+    std::size_t kilobytes{0};
+    while (std::getline(smaps, line)) {
+        // a mapping starts with a line like "7f0000000000-7f0000400000 rw-p ..."
+        const auto dash = line.find('-');
+        const auto space = line.find(' ');
+        if (dash != std::string::npos && space != std::string::npos && dash < space) {
+            const auto mapping_begin = parse_address(line.data(), line.data() + dash);
+            const auto mapping_end = parse_address(line.data() + dash + 1, line.data() + space);
+            if (mapping_begin.has_value() && mapping_end.has_value()) {
+                in_range = *mapping_begin < range_end && range_begin < *mapping_end;
+                continue;
+            }
+        }
+        constexpr std::string_view key{"AnonHugePages:"};
+        if (in_range && line.starts_with(key)) {
+            const auto first = line.find_first_not_of(' ', key.size());
+            std::size_t value{0};
+            if (first != std::string::npos) {
+                std::from_chars(line.data() + first, line.data() + line.size(), value);
+            }
+            kilobytes += value;
+        }
+    }
+    return kilobytes * 1024;
+}
+
+// maps anonymous memory aligned to a huge page; the kernel zeroes each page on its first access
+auto map_aligned(std::size_t size) -> void * {
+    const auto padded_size = size + HugePageMemory::huge_page_size;
+    void *mapped = mmap(nullptr, padded_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (mapped == MAP_FAILED) {
+        throw std::bad_alloc{};
+    }
+    // return the parts before and after the aligned block to the system
+    const auto begin = reinterpret_cast<std::uintptr_t>(mapped);
+    const auto aligned = (begin + HugePageMemory::huge_page_size - 1) / HugePageMemory::huge_page_size * HugePageMemory::huge_page_size;
+    const auto head = aligned - begin;
+    const auto tail = padded_size - head - size;
+    if (head != 0) {
+        munmap(mapped, head);
+    }
+    if (tail != 0) {
+        munmap(reinterpret_cast<void *>(aligned + size), tail);
+    }
+    return reinterpret_cast<void *>(aligned);
+}
+
+#else
+
+// alignment of blocks with regular pages
+constexpr std::size_t cache_line_size{64};
+
+#endif
+
+} // namespace
+
+HugePageMemory::HugePageMemory(std::size_t size, [[maybe_unused]] HugePageOptions options) : m_size{size} {
+    if (size == 0) {
+        return;
+    }
+#if defined(__linux__)
+    m_allocated_size = (size + huge_page_size - 1) / huge_page_size * huge_page_size;
+    void *mapped = mmap(nullptr, m_allocated_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+    if (mapped != MAP_FAILED) {
+        m_data = mapped;
+        m_page_kind = PageKind::Explicit;
+    } else {
+        m_data = map_aligned(m_allocated_size);
+        if (madvise(m_data, m_allocated_size, MADV_HUGEPAGE) == 0) {
+            m_page_kind = PageKind::Advised;
+        }
+    }
+    if (options.prefault) {
+        std::memset(m_data, 0, m_allocated_size);
+    }
+    if (options.verify && m_page_kind == PageKind::Advised) {
+        // touching the first huge page makes the kernel back it, then we can see with what
+        if (!options.prefault) {
+            std::memset(m_data, 0, huge_page_size);
+        }
+        m_page_kind = transparent_huge_page_bytes(m_data, huge_page_size) > 0 ? PageKind::Transparent : PageKind::Regular;
+    }
+#else
+    m_allocated_size = size;
+    m_data = ::operator new(m_allocated_size, std::align_val_t{cache_line_size});
+    std::memset(m_data, 0, m_allocated_size);
+#endif
+}
+
+HugePageMemory::HugePageMemory(HugePageMemory &&other) noexcept
+    : m_data{std::exchange(other.m_data, nullptr)},
+      m_size{std::exchange(other.m_size, 0)},
+      m_allocated_size{std::exchange(other.m_allocated_size, 0)},
+      m_page_kind{std::exchange(other.m_page_kind, PageKind::Regular)} {}
+
+auto HugePageMemory::operator=(HugePageMemory &&other) noexcept -> HugePageMemory & {
+    if (this != &other) {
+        release();
+        m_data = std::exchange(other.m_data, nullptr);
+        m_size = std::exchange(other.m_size, 0);
+        m_allocated_size = std::exchange(other.m_allocated_size, 0);
+        m_page_kind = std::exchange(other.m_page_kind, PageKind::Regular);
+    }
+    return *this;
+}
+
+HugePageMemory::~HugePageMemory() {
+    release();
+}
+
+auto HugePageMemory::release() -> void {
+    if (m_data == nullptr) {
+        return;
+    }
+#if defined(__linux__)
+    munmap(m_data, m_allocated_size);
+#else
+    ::operator delete(m_data, std::align_val_t{cache_line_size});
+#endif
+    m_data = nullptr;
+    m_size = 0;
+    m_allocated_size = 0;
+    m_page_kind = PageKind::Regular;
+}
+
+} // namespace chesscore
@@ -4,43 +4,161 @@
  * ************************************************************************** */
 
 #include "chesscore/position.h"
+#include "chesscore/bitboard_tables.h"
+
+#include <algorithm>
+#include <limits>
 
 namespace chesscore {
 
-auto Position::make_move(const Move &move) -> void {
-    move_piece_hash(move);
-    m_board.make_move(move);
-    updateFullmoveNumber();
-    updateHalfmoveClock(move);
-    updateEnPassant(move);
-    updateCastlingRights(move);
-    m_state.side_to_move = other_color(m_state.side_to_move);
-    m_hash.swap_side();
+namespace {
+
+// order in which attackers join an exchange
+constexpr std::array<PieceType, piece_type_count> exchange_order{PieceType::Pawn, PieceType::Knight, PieceType::Bishop, PieceType::Rook, PieceType::Queen, PieceType::King};
+
+// value the move wins before any recapture
+auto initial_exchange_gain(const Move &move) -> int {
+    int gain = move.captured.has_value() ? piece_value(move.captured->type) : 0;
+    if (move.promoted.has_value()) {
+        gain += piece_value(move.promoted->type) - piece_value(PieceType::Pawn);
+    }
+    return gain;
+}
+
+// square of the piece captured by the move
+auto capture_square(const Move &move) -> Square {
+    return move.capturing_en_passant ? Square{move.to.file(), move.from.rank()} : move.to;
 }
 
-auto Position::move_piece_hash(const Move &move) -> void {
+// origin and destination of the rook in a castling move
+auto castling_rook_squares(const Move &move) -> std::pair<Square, Square> {
+    if (move.from.file().file < move.to.file().file) {
+        // Kingside castling
+        return {Square{File{'H'}, move.to.rank()}, Square{File{'F'}, move.to.rank()}};
+    }
+    // Queenside castling
+    return {Square{File{'A'}, move.to.rank()}, Square{File{'D'}, move.to.rank()}};
+}
+
+// applies the changes of a move to the hash of the position, given the state before the move;
+// since the changes are XORed in, applying them again undoes the move
+auto update_key(ZobristHash &key, const Move &move, const PositionState &before) -> void {
     if (move.is_capture()) {
-        if (move.capturing_en_passant) {
-            m_hash.clear_piece(move.captured.value(), Square{move.to.file(), move.from.rank()});
-        } else {
-            m_hash.clear_piece(move.captured.value(), move.to);
-        }
+        key.clear_piece(move.captured.value(), capture_square(move));
     }
     if (move.promoted) {
-        m_hash.clear_piece(move.piece, move.from);
-        m_hash.set_piece(move.promoted.value(), move.to);
+        key.clear_piece(move.piece, move.from);
+        key.set_piece(move.promoted.value(), move.to);
     } else {
-        m_hash.move_piece(move.piece, move.from, move.to);
+        key.move_piece(move.piece, move.from, move.to);
     }
     if (move.is_castling()) {
-        if (move.from.file().file < move.to.file().file) {
-            // Kingside castling
-            m_hash.move_piece(Piece{.type = PieceType::Rook, .color = move.piece.color}, Square{File{'H'}, move.to.rank()}, Square{File{'F'}, move.to.rank()});
-        } else {
-            // Queenside castling
-            m_hash.move_piece(Piece{.type = PieceType::Rook, .color = move.piece.color}, Square{File{'A'}, move.to.rank()}, Square{File{'D'}, move.to.rank()});
-        }
+        const auto [rook_from, rook_to] = castling_rook_squares(move);
+        key.move_piece(Piece{.type = PieceType::Rook, .color = move.piece.color}, rook_from, rook_to);
     }
+    if (before.en_passant_target.has_value()) {
+        key.clear_enpassant(before.en_passant_target.value().file());
+    }
+    if (move.piece.type == PieceType::Pawn && move.is_double_step()) {
+        key.set_enpassant(move.from.file());
+    }
+    CastlingRights rights{before.castling_rights};
+    rights.keep(CastlingRights::preserved_by(move.from) & CastlingRights::preserved_by(move.to));
+    if (rights != before.castling_rights) {
+        key.switch_castling(before.castling_rights, rights);
+    }
+    key.swap_side();
+}
+
+// records a piece in the additional hashes; the count includes the piece
+auto add_piece_keys(HistoryEntry &entry, const Piece &piece, const Square &square, int count) -> void {
+    if (piece.type == PieceType::Pawn) {
+        entry.pawn_hash.set_piece(piece, square);
+    } else {
+        entry.non_pawn_hash[get_index(piece.color)].set_piece(piece, square);
+    }
+    entry.material_hash.toggle_material(piece, count - 1);
+}
+
+// removes a piece from the additional hashes; the count excludes the piece
+auto remove_piece_keys(HistoryEntry &entry, const Piece &piece, const Square &square, int count) -> void {
+    if (piece.type == PieceType::Pawn) {
+        entry.pawn_hash.clear_piece(piece, square);
+    } else {
+        entry.non_pawn_hash[get_index(piece.color)].clear_piece(piece, square);
+    }
+    entry.material_hash.toggle_material(piece, count);
+}
+
+auto move_piece_keys(HistoryEntry &entry, const Piece &piece, const Square &from, const Square &to) -> void {
+    if (piece.type == PieceType::Pawn) {
+        entry.pawn_hash.move_piece(piece, from, to);
+    } else {
+        entry.non_pawn_hash[get_index(piece.color)].move_piece(piece, from, to);
+    }
+}
+
+// applies the changes of a move to the additional hashes, given the board after the move
+auto update_piece_keys(HistoryEntry &entry, const Move &move, const Bitboard &board) -> void {
+    if (move.is_capture()) {
+        remove_piece_keys(entry, move.captured.value(), capture_square(move), board.piece_count(move.captured.value()));
+    }
+    if (move.promoted) {
+        remove_piece_keys(entry, move.piece, move.from, board.piece_count(move.piece));
+        add_piece_keys(entry, move.promoted.value(), move.to, board.piece_count(move.promoted.value()));
+    } else {
+        move_piece_keys(entry, move.piece, move.from, move.to);
+    }
+    if (move.is_castling()) {
+        const auto [rook_from, rook_to] = castling_rook_squares(move);
+        move_piece_keys(entry, Piece{.type = PieceType::Rook, .color = move.piece.color}, rook_from, rook_to);
+    }
+}
+
+// computes the additional hashes of all pieces on the board
+auto add_board_keys(HistoryEntry &entry, const Bitboard &board) -> void {
+    std::array<int, max_black_piece_index + 1> counts{};
+    for (const auto square : board.occupied()) {
+        const auto piece = board.get_piece(square).value();
+        add_piece_keys(entry, piece, square, ++counts[piece.piece_index()]);
+    }
+}
+
+// the additional hashes of a board without a history
+auto board_keys(const Bitboard &board) -> HistoryEntry {
+    HistoryEntry entry{};
+    add_board_keys(entry, board);
+    return entry;
+}
+
+// the halfmove clock saturates instead of wrapping around
+auto advance_clock(std::uint8_t clock) -> std::uint8_t {
+    return clock == std::numeric_limits<std::uint8_t>::max() ? clock : static_cast<std::uint8_t>(clock + 1);
+}
+
+} // namespace
+
+auto Position::make_move(const Move &move) -> void {
+    claim_history_entry();
+    update_key(m_hash, move, m_state);
+    m_board.make_move(move);
+    updateFullmoveNumber();
+    updateHalfmoveClock(move);
+    updateEnPassant(move);
+    updateCastlingRights(move);
+    m_state.side_to_move = other_color(m_state.side_to_move);
+    if (m_history != nullptr) {
+        auto &entry = m_history->record(ply());
+        entry.hash = m_hash;
+        update_piece_keys(entry, move, m_board);
+    }
+    m_board.update_check_info(m_state);
+}
+
+auto Position::key_after(const Move &move) const -> ZobristHash {
+    ZobristHash key{m_hash};
+    update_key(key, move, m_state);
+    return key;
 }
 
 auto Position::updateFullmoveNumber() -> void {
@@ -53,7 +171,7 @@ auto Position::updateHalfmoveClock(const Move &move) -> void {
     if (move.is_capture() || move.piece.type == PieceType::Pawn) {
         m_state.halfmove_clock = 0;
     } else {
-        m_state.halfmove_clock++;
+        m_state.halfmove_clock = advance_clock(m_state.halfmove_clock);
     }
 }
 
@@ -64,86 +182,59 @@ auto Position::updateEnPassant(const Move &move) -> void {
         } else {
             m_state.en_passant_target = Square{File{move.from.file().file}, Rank{move.from.rank().rank + 1}};
         }
-        m_hash.set_enpassant(move.from.file());
     } else {
-        if (m_state.en_passant_target.has_value()) {
-            m_hash.clear_enpassant(m_state.en_passant_target->file());
-        }
         m_state.en_passant_target.reset();
     }
 }
 
 auto Position::updateCastlingRights(const Move &move) -> void {
-    CastlingRights old_rights = m_state.castling_rights;
-    if (move.piece == Piece::WhiteKing) {
-        m_state.castling_rights['K'] = false;
-        m_state.castling_rights['Q'] = false;
-    } else if (move.piece == Piece::WhiteRook) {
-        if (move.from == Square::H1) {
-            m_state.castling_rights['K'] = false;
-        } else if (move.from == Square::A1) {
-            m_state.castling_rights['Q'] = false;
-        }
-    } else if (move.piece == Piece::BlackKing) {
-        m_state.castling_rights['k'] = false;
-        m_state.castling_rights['q'] = false;
-    } else if (move.piece == Piece::BlackRook) {
-        if (move.from == Square::H8) {
-            m_state.castling_rights['k'] = false;
-        } else if (move.from == Square::A8) {
-            m_state.castling_rights['q'] = false;
-        }
-    }
-    if (move.is_capture()) {
-        if (move.to == Square::A1) {
-            m_state.castling_rights['Q'] = false;
-        } else if (move.to == Square::H1) {
-            m_state.castling_rights['K'] = false;
-        } else if (move.to == Square::A8) {
-            m_state.castling_rights['q'] = false;
-        } else if (move.to == Square::H8) {
-            m_state.castling_rights['k'] = false;
-        }
-    }
-    if (m_state.castling_rights != old_rights) {
-        m_hash.switch_castling(old_rights, m_state.castling_rights);
-    }
+    m_state.castling_rights.keep(CastlingRights::preserved_by(move.from) & CastlingRights::preserved_by(move.to));
 }
 
 auto Position::unmake_move(const Move &move) -> void {
-    unmove_piece_hash(move);
     m_board.unmake_move(move);
     resetFullmoveNumber(move);
     resetHalfmoveClock(move);
     resetEnPassant(move);
     resetCastlingRights(move);
     m_state.side_to_move = other_color(m_state.side_to_move);
-    m_hash.swap_side();
+    update_key(m_hash, move, m_state);
+    m_board.update_check_info(m_state);
 }
 
-auto Position::unmove_piece_hash(const Move &move) -> void {
-    if (move.promoted) {
-        m_hash.clear_piece(move.promoted.value(), move.to);
-        m_hash.set_piece(move.piece, move.from);
-    } else {
-        m_hash.move_piece(move.piece, move.to, move.from);
+auto Position::make_null_move() -> NullMove {
+    claim_history_entry();
+    const NullMove null_move{.halfmove_clock_before = m_state.halfmove_clock, .en_passant_target_before = m_state.en_passant_target};
+    updateFullmoveNumber();
+    m_state.halfmove_clock = advance_clock(m_state.halfmove_clock);
+    if (m_state.en_passant_target.has_value()) {
+        m_hash.clear_enpassant(m_state.en_passant_target.value().file());
+        m_state.en_passant_target.reset();
     }
-    if (move.is_capture()) {
-        if (move.capturing_en_passant) {
-            m_hash.set_piece(move.captured.value(), Square{move.to.file(), move.from.rank()});
-        } else {
-            m_hash.set_piece(move.captured.value(), move.to);
-        }
+    m_state.side_to_move = other_color(m_state.side_to_move);
+    m_hash.swap_side();
+    if (m_history != nullptr) {
+        auto &entry = m_history->record(ply());
+        entry.hash = m_hash;
+        // the null move is not a legal move, so no repetition reaches across it
+        entry.previous = 0;
     }
-    if (move.is_castling()) {
-        if (move.from.file().file < move.to.file().file) {
-            // Kingside castling
-            m_hash.move_piece(Piece{.type = PieceType::Rook, .color = move.piece.color}, Square{File{'F'}, move.from.rank()}, Square{File{'H'}, move.from.rank()});
-        } else {
-            // Queenside castling
-            m_hash.move_piece(Piece{.type = PieceType::Rook, .color = move.piece.color}, Square{File{'D'}, move.from.rank()}, Square{File{'A'}, move.from.rank()});
-        }
+    m_board.update_check_info(m_state);
+    return null_move;
+}
+
+auto Position::unmake_null_move(const NullMove &null_move) -> void {
+    m_state.side_to_move = other_color(m_state.side_to_move);
+    m_hash.swap_side();
+    if (m_state.side_to_move == Color::Black) {
+        m_state.fullmove_number--;
+    }
+    m_state.halfmove_clock = static_cast<std::uint8_t>(null_move.halfmove_clock_before);
+    if (null_move.en_passant_target_before.has_value()) {
+        m_state.en_passant_target = null_move.en_passant_target_before;
+        m_hash.set_enpassant(m_state.en_passant_target.value().file());
     }
+    m_board.update_check_info(m_state);
 }
 
 auto Position::resetFullmoveNumber(const Move &move) -> void {
@@ -153,25 +244,18 @@ auto Position::resetFullmoveNumber(const Move &move) -> void {
 }
 
 auto Position::resetHalfmoveClock(const Move &move) -> void {
-    m_state.halfmove_clock = move.halfmove_clock_before;
+    m_state.halfmove_clock = static_cast<std::uint8_t>(move.halfmove_clock_before);
 }
 
 auto Position::resetEnPassant(const Move &move) -> void {
-    if (m_state.en_passant_target.has_value()) {
-        m_hash.clear_enpassant(m_state.en_passant_target->file());
-    }
     if (move.en_passant_target_before.has_value()) {
         m_state.en_passant_target = move.en_passant_target_before;
-        m_hash.set_enpassant(m_state.en_passant_target->file());
     } else {
         m_state.en_passant_target.reset();
     }
 }
 
 auto Position::resetCastlingRights(const Move &move) -> void {
-    if (m_state.castling_rights != move.castling_rights_before) {
-        m_hash.switch_castling(m_state.castling_rights, move.castling_rights_before);
-    }
     m_state.castling_rights = move.castling_rights_before;
 }
 
@@ -184,7 +268,10 @@ auto Position::capture_moves() const -> MoveList {
 }
 
 auto Position::is_king_in_check(Color color) const -> bool {
-    const auto king_sq = m_board.find_king(color);
+    if (color == m_state.side_to_move) {
+        return !m_state.checkers.empty();
+    }
+    const auto king_sq = m_state.king_square[get_index(color)];
     if (king_sq.has_value()) {
         return m_board.is_attacked(king_sq.value(), other_color(color));
     }
@@ -192,18 +279,135 @@ auto Position::is_king_in_check(Color color) const -> bool {
 }
 
 auto Position::check_state() const -> CheckState {
-    if (is_king_in_check(m_state.side_to_move)) {
-        if (all_legal_moves().empty()) {
-            return CheckState::Checkmate;
-        } else {
-            return CheckState::Check;
+    const bool in_check = is_king_in_check(m_state.side_to_move);
+    const bool no_moves = !has_legal_move();
+    if (in_check) {
+        return no_moves ? CheckState::Checkmate : CheckState::Check;
+    }
+    return no_moves ? CheckState::Stalemate : CheckState::None;
+}
+
+auto Position::see(const Move &move) const -> int {
+    if (move.is_castling()) {
+        return 0;
+    }
+    const auto &target = move.to;
+    auto occupancy = m_board.occupied();
+    occupancy.clear(move.from);
+    if (move.capturing_en_passant) {
+        occupancy.clear(Square{target.file(), move.from.rank()});
+    }
+    auto attackers = m_board.attackers_to(target, occupancy) & occupancy;
+
+    std::array<int, 32> gain{};
+    std::size_t depth = 0;
+    gain[0] = initial_exchange_gain(move);
+    int piece_on_target = piece_value(move.promoted.has_value() ? move.promoted->type : move.piece.type);
+    Color side = other_color(move.piece.color);
+    while (depth + 1 < gain.size()) {
+        auto side_attackers = attackers & m_board.bitmap(side);
+        const auto king = m_state.king_square[get_index(side)];
+        if (king.has_value()) {
+            // pinned pieces may only capture along the pin line
+            for (const auto pinned : side_attackers & m_state.king_blockers[get_index(side)]) {
+                if (!bitmaps::line(king.value(), pinned).get(target)) {
+                    side_attackers.clear(pinned);
+                }
+            }
         }
-    } else {
-        if (all_legal_moves().empty()) {
-            return CheckState::Stalemate;
+        if (side_attackers.empty()) {
+            break;
+        }
+        const auto attacker_type = *std::ranges::find_if(exchange_order, [&](PieceType type) { return !(side_attackers & m_board.bitmap(type)).empty(); });
+        const auto attacker = (side_attackers & m_board.bitmap(attacker_type)).lsb();
+        occupancy.clear(attacker);
+        attackers = m_board.attackers_to(target, occupancy) & occupancy;
+        if (attacker_type == PieceType::King && !(attackers & m_board.bitmap(other_color(side))).empty()) {
+            // the king cannot capture a defended piece
+            break;
         }
+        ++depth;
+        gain[depth] = piece_on_target - gain[depth - 1];
+        piece_on_target = piece_value(attacker_type);
+        side = other_color(side);
+    }
+    while (depth > 0) {
+        gain[depth - 1] = -std::max(-gain[depth - 1], gain[depth]);
+        --depth;
+    }
+    return gain[0];
+}
+
+auto Position::see_ge(const Move &move, int threshold) const -> bool {
+    const int gain = initial_exchange_gain(move);
+    if (gain < threshold) {
+        // recaptures can only reduce the gain
+        return false;
+    }
+    const int piece_on_target = piece_value(move.promoted.has_value() ? move.promoted->type : move.piece.type);
+    if (gain - piece_on_target >= threshold) {
+        // even losing the moving piece keeps the threshold
+        return true;
+    }
+    return see(move) >= threshold;
+}
+
+auto Position::attach_history(HashHistory &history) -> void {
+    if (m_history == &history) {
+        return;
+    }
+    if (m_history != nullptr) {
+        claim_history_entry();
+        history = *m_history;
+        m_history = &history;
+    } else {
+        m_history = &history;
+        start_history();
+    }
+}
+
+auto Position::start_history() -> void {
+    auto &entry = m_history->start(ply());
+    entry.hash = m_hash;
+    add_board_keys(entry, m_board);
+}
+
+auto Position::claim_history_entry() -> void {
+    if (m_history != nullptr && !owns_history_entry()) {
+        // a copy of the position overwrote the entry, so the earlier positions are lost
+        start_history();
+    }
+}
+
+auto Position::recorded_keys() const -> const HistoryEntry * {
+    return m_history != nullptr && owns_history_entry() ? &m_history->entry(ply()) : nullptr;
+}
+
+auto Position::pawn_hash() const -> ZobristHash {
+    const auto *keys = recorded_keys();
+    return keys != nullptr ? keys->pawn_hash : board_keys(m_board).pawn_hash;
+}
+
+auto Position::non_pawn_hash(Color color) const -> ZobristHash {
+    const auto *keys = recorded_keys();
+    return keys != nullptr ? keys->non_pawn_hash[get_index(color)] : board_keys(m_board).non_pawn_hash[get_index(color)];
+}
+
+auto Position::material_hash() const -> ZobristHash {
+    const auto *keys = recorded_keys();
+    return keys != nullptr ? keys->material_hash : board_keys(m_board).material_hash;
+}
+
+auto Position::is_repetition(int count) const -> bool {
+    if (count <= 1) {
+        return true;
+    }
+    if (m_history == nullptr || !owns_history_entry()) {
+        // no earlier positions are known
+        return false;
     }
-    return CheckState::None;
+    const auto previous = count - 1;
+    return m_history->count(ply(), static_cast<std::size_t>(m_state.halfmove_clock), previous) >= previous;
 }
 
 auto Position::piece_placement() const -> PiecePlacement {
@@ -0,0 +1,537 @@
+/* ************************************************************************** *
+ * Chess Core                                                                 *
+ * Data structures and algorithms for chess                                   *
+ * ************************************************************************** */
+
+#include "chesscore/search.h"
+
+#include <algorithm>
+#include <array>
+#include <cstdlib>
+#include <initializer_list>
+#include <memory>
+#include <thread>
+
+namespace chesscore::search {
+
+namespace {
+
+// bonus for pieces near the center of the board, 0 (corner) to 6 (center)
+constexpr auto centralization = [] {
+    std::array<int, Square::count> table{};
+    for (std::size_t index = 0; index < table.size(); ++index) {
+        const auto file = static_cast<int>(index % 8);
+        const auto rank = static_cast<int>(index / 8);
+        table[index] = 7 - (std::abs(2 * file - 7) + std::abs(2 * rank - 7)) / 2;
+    }
+    return table;
+}();
+
+// bonus for pawns by the number of ranks they advanced
+constexpr std::array<int, 8> pawn_advance_bonus{0, 0, 4, 8, 16, 30, 50, 0};
+
+// weight of the centralization bonus for each piece type (Pawn, Rook, Knight, Bishop, Queen, King)
+constexpr std::array<int, piece_type_count> centralization_weight{0, 1, 5, 3, 1, -3};
+constexpr int endgame_king_centralization_weight{4};
+
+constexpr std::size_t max_moves{256};
+constexpr std::uint64_t node_check_interval{1024};
+
+// scores used for move ordering
+constexpr int table_move_order{1'000'000};
+constexpr int capture_order{100'000};
+constexpr int first_killer_order{90'000};
+constexpr int second_killer_order{80'000};
+constexpr int history_limit{50'000};
+
+auto score_to_table(int score, int ply) -> std::int16_t {
+    if (score >= mate_score - max_ply) {
+        score += ply;
+    } else if (score <= -mate_score + max_ply) {
+        score -= ply;
+    }
+    return static_cast<std::int16_t>(score);
+}
+
+auto score_from_table(int score, int ply) -> int {
+    if (score >= mate_score - max_ply) {
+        return score - ply;
+    }
+    if (score <= -mate_score + max_ply) {
+        return score + ply;
+    }
+    return score;
+}
+
+auto is_quiet(const Move &move) -> bool {
+    return !move.is_capture() && !move.is_pawn_promotion();
+}
+
+auto has_non_pawn_material(const Position &position, Color color) -> bool {
+    const auto &board = position.board();
+    return !(board.bitmap(color) & ~(board.bitmap(PieceType::Pawn) | board.bitmap(PieceType::King))).empty();
+}
+
+struct ScoredMove {
+    Move move;
+    int order{0};
+};
+
+struct MoveBuffer {
+    std::array<ScoredMove, max_moves> moves;
+    std::size_t size{0};
+};
+
+struct RootMove {
+    Move move;
+    int score{-infinite_score};
+    std::array<PackedMove, max_ply + 1> pv{};
+    int pv_length{0};
+};
+
+// state shared by all threads of a search
+struct SharedState {
+    TranspositionTable &table;
+    Evaluator evaluator;
+    std::atomic<SearchState> &state;
+    Limits limits;
+    std::chrono::steady_clock::time_point start;
+    std::atomic<std::uint64_t> nodes{0};
+};
+
+class Worker {
+public:
+    Worker(SharedState &shared, const Position &position, int id) : m_shared{shared}, m_position{position}, m_id{id} { m_position.attach_history(m_game_history); }
+
+    auto run() -> void;
+
+    auto completed_depth() const -> int { return m_completed_depth; }
+    auto completed_lines() const -> const std::vector<RootMove> & { return m_completed; }
+    auto flush_nodes() -> void {
+        m_shared.nodes.fetch_add(m_unreported_nodes, std::memory_order_relaxed);
+        m_unreported_nodes = 0;
+    }
+private:
+    auto search_root(int depth, std::size_t pv_index) -> void;
+    auto search(int alpha, int beta, int depth, int ply, bool pv_node, bool allow_null) -> int;
+    auto quiescence(int alpha, int beta, int ply) -> int;
+
+    auto generate_moves(int ply, bool captures_only) -> MoveBuffer &;
+    auto order_moves(MoveBuffer &buffer, int ply, PackedMove table_move) const -> void;
+    static auto pick_move(MoveBuffer &buffer, std::size_t index) -> const Move &;
+    auto update_pv(int ply, const Move &move) -> void;
+    auto update_quiet_stats(const Move &move, int ply, int depth) -> void;
+
+    auto count_node() -> void;
+    auto stopped() const -> bool { return m_shared.state.load(std::memory_order_relaxed) == SearchState::Stopping && (m_completed_depth > 0 || m_id != 0); }
+    auto evaluate() const -> int { return m_shared.evaluator(m_position); }
+
+    SharedState &m_shared;
+    Position m_position;
+    HashHistory m_game_history{};
+    int m_id;
+
+    std::vector<MoveBuffer> m_moves{static_cast<std::size_t>(max_ply + 1)};
+    std::vector<std::array<PackedMove, max_ply + 1>> m_pv{static_cast<std::size_t>(max_ply + 1)};
+    std::array<int, max_ply + 1> m_pv_length{};
+    std::array<std::array<PackedMove, 2>, max_ply + 1> m_killers{};
+    std::array<std::array<std::array<int, Square::count>, Square::count>, 2> m_history{};
+
+    std::vector<RootMove> m_root_moves{};
+    std::vector<RootMove> m_completed{};
+    int m_completed_depth{0};
+    std::uint64_t m_unreported_nodes{0};
+};
+
+auto Worker::run() -> void {
+    m_position.generate([this](const Move &move) { m_root_moves.push_back(RootMove{.move = move}); });
+    if (m_root_moves.empty()) {
+        return;
+    }
+    const auto line_count = std::min(static_cast<std::size_t>(std::max(m_shared.limits.multi_pv, 1)), m_root_moves.size());
+    const int depth_limit = std::clamp(m_shared.limits.depth, 1, max_depth);
+    for (int depth = 1; depth <= depth_limit; ++depth) {
+        // every second helper thread searches one ply deeper, to spread the threads over the depths
+        const int search_depth = m_id % 2 == 1 ? std::min(depth + 1, depth_limit) : depth;
+        for (std::size_t pv_index = 0; pv_index < line_count && !stopped(); ++pv_index) {
+            search_root(search_depth, pv_index);
+        }
+        if (stopped()) {
+            break;
+        }
+        m_completed_depth = search_depth;
+        m_completed.assign(m_root_moves.begin(), m_root_moves.begin() + static_cast<std::ptrdiff_t>(line_count));
+        // a mate found within the searched depth cannot be improved
+        if (m_id == 0 && line_count == 1 && mate_score - m_root_moves.front().score <= search_depth) {
+            break;
+        }
+    }
+    flush_nodes();
+}
+
+auto Worker::search_root(int depth, std::size_t pv_index) -> void {
+    int alpha = -infinite_score;
+    const int beta = infinite_score;
+    for (std::size_t index = pv_index; index < m_root_moves.size(); ++index) {
+        auto &root_move = m_root_moves[index];
+        m_position.make_move(root_move.move);
+        int score{};
+        if (index == pv_index) {
+            score = -search(-beta, -alpha, depth - 1, 1, true, true);
+        } else {
+            score = -search(-alpha - 1, -alpha, depth - 1, 1, false, true);
+            if (score > alpha && !stopped()) {
+                score = -search(-beta, -alpha, depth - 1, 1, true, true);
+            }
+        }
+        m_position.unmake_move(root_move.move);
+        if (stopped()) {
+            return;
+        }
+        if (index == pv_index || score > alpha) {
+            alpha = std::max(alpha, score);
+            root_move.score = score;
+            root_move.pv[0] = PackedMove{root_move.move};
+            root_move.pv_length = std::max(m_pv_length[1], 1);
+            std::copy(m_pv[1].begin() + 1, m_pv[1].begin() + root_move.pv_length, root_move.pv.begin() + 1);
+        } else {
+            root_move.score = -infinite_score;
+        }
+    }
+    std::stable_sort(m_root_moves.begin() + static_cast<std::ptrdiff_t>(pv_index), m_root_moves.end(), [](const RootMove &lhs, const RootMove &rhs) {
+        return lhs.score > rhs.score;
+    });
+}
+
+auto Worker::search(int alpha, int beta, int depth, int ply, bool pv_node, bool allow_null) -> int {
+    m_pv_length[static_cast<std::size_t>(ply)] = ply;
+    if (depth <= 0) {
+        return quiescence(alpha, beta, ply);
+    }
+    count_node();
+    if (stopped()) {
+        return 0;
+    }
+    if (m_position.is_repetition(2) || m_position.is_fifty_move_draw()) {
+        return 0;
+    }
+    if (ply >= max_ply) {
+        return evaluate();
+    }
+    // mate distance pruning
+    alpha = std::max(alpha, -mate_score + ply);
+    beta = std::min(beta, mate_score - ply - 1);
+    if (alpha >= beta) {
+        return alpha;
+    }
+
+    const auto key = m_position.hash();
+    PackedMove table_move{};
+    if (const auto entry = m_shared.table.probe(key)) {
+        table_move = entry->move;
+        const int score = score_from_table(entry->score, ply);
+        if (!pv_node && entry->depth >= depth &&
+            (entry->bound == Bound::Exact || (entry->bound == Bound::Lower && score >= beta) || (entry->bound == Bound::Upper && score <= alpha))) {
+            return score;
+        }
+    }
+
+    const bool in_check = !m_position.checkers().empty();
+    if (in_check) {
+        ++depth;
+    }
+
+    if (!pv_node && !in_check && allow_null && depth >= 3 && has_non_pawn_material(m_position, m_position.side_to_move()) && evaluate() >= beta) {
+        const int reduction = 3 + depth / 4;
+        const auto null_move = m_position.make_null_move();
+        const int score = -search(-beta, -beta + 1, depth - reduction, ply + 1, false, false);
+        m_position.unmake_null_move(null_move);
+        if (stopped()) {
+            return 0;
+        }
+        if (score >= beta) {
+            return is_mate_score(score) ? beta : score;
+        }
+    }
+
+    auto &buffer = generate_moves(ply, false);
+    if (buffer.size == 0) {
+        return in_check ? -mate_score + ply : 0;
+    }
+    order_moves(buffer, ply, table_move);
+
+    const int original_alpha = alpha;
+    int best_score = -infinite_score;
+    PackedMove best_move{};
+    for (std::size_t index = 0; index < buffer.size; ++index) {
+        const auto &move = pick_move(buffer, index);
+        m_shared.table.prefetch(m_position.key_after(move));
+        m_position.make_move(move);
+        const bool gives_check = !m_position.checkers().empty();
+        int score{};
+        if (index == 0) {
+            score = -search(-beta, -alpha, depth - 1, ply + 1, pv_node, true);
+        } else {
+            int reduction{0};
+            if (depth >= 3 && index >= 3 && !in_check && !gives_check && is_quiet(move)) {
+                reduction = index >= 8 ? 2 : 1;
+            }
+            score = -search(-alpha - 1, -alpha, depth - 1 - reduction, ply + 1, false, true);
+            if (reduction > 0 && score > alpha) {
+                score = -search(-alpha - 1, -alpha, depth - 1, ply + 1, false, true);
+            }
+            if (pv_node && score > alpha && score < beta) {
+                score = -search(-beta, -alpha, depth - 1, ply + 1, true, true);
+            }
+        }
+        m_position.unmake_move(move);
+        if (stopped()) {
+            return 0;
+        }
+        if (score > best_score) {
+            best_score = score;
+            best_move = PackedMove{move};
+            if (score > alpha) {
+                alpha = score;
+                update_pv(ply, move);
+                if (score >= beta) {
+                    if (is_quiet(move)) {
+                        update_quiet_stats(move, ply, depth);
+                    }
+                    break;
+                }
+            }
+        }
+    }
+
+    const Bound bound = best_score >= beta ? Bound::Lower : (best_score > original_alpha ? Bound::Exact : Bound::Upper);
+    m_shared.table.store(key, TranspositionData{
+                                  .move = best_move,
+                                  .score = score_to_table(best_score, ply),
+                                  .depth = static_cast<std::int8_t>(std::min(depth, max_depth)),
+                                  .bound = bound,
+                              });
+    return best_score;
+}
+
+auto Worker::quiescence(int alpha, int beta, int ply) -> int {
+    m_pv_length[static_cast<std::size_t>(ply)] = ply;
+    count_node();
+    if (stopped()) {
+        return 0;
+    }
+    if (ply >= max_ply) {
+        return evaluate();
+    }
+    const bool in_check = !m_position.checkers().empty();
+    int best_score = -infinite_score;
+    if (!in_check) {
+        best_score = evaluate();
+        if (best_score >= beta) {
+            return best_score;
+        }
+        alpha = std::max(alpha, best_score);
+    }
+
+    auto &buffer = generate_moves(ply, !in_check);
+    if (in_check && buffer.size == 0) {
+        return -mate_score + ply;
+    }
+    order_moves(buffer, ply, PackedMove{});
+    for (std::size_t index = 0; index < buffer.size; ++index) {
+        const auto &move = pick_move(buffer, index);
+        if (!in_check && move.is_capture() && !m_position.see_ge(move)) {
+            continue;
+        }
+        m_position.make_move(move);
+        const int score = -quiescence(-beta, -alpha, ply + 1);
+        m_position.unmake_move(move);
+        if (stopped()) {
+            return 0;
+        }
+        if (score > best_score) {
+            best_score = score;
+            if (score > alpha) {
+                alpha = score;
+                update_pv(ply, move);
+                if (score >= beta) {
+                    break;
+                }
+            }
+        }
+    }
+    return best_score;
+}
+
+auto Worker::generate_moves(int ply, bool captures_only) -> MoveBuffer & {
+    auto &buffer = m_moves[static_cast<std::size_t>(ply)];
+    buffer.size = 0;
+    m_position.generate([&buffer, captures_only](const Move &move) {
+        if (!captures_only || !is_quiet(move)) {
+            buffer.moves[buffer.size++].move = move;
+        }
+        return buffer.size < max_moves;
+    });
+    return buffer;
+}
+
+auto Worker::order_moves(MoveBuffer &buffer, int ply, PackedMove table_move) const -> void {
+    const auto &killers = m_killers[static_cast<std::size_t>(ply)];
+    const auto &history = m_history[get_index(m_position.side_to_move())];
+    for (std::size_t index = 0; index < buffer.size; ++index) {
+        auto &scored = buffer.moves[index];
+        const auto &move = scored.move;
+        if (table_move.matches(move)) {
+            scored.order = table_move_order;
+        } else if (!is_quiet(move)) {
+            const int victim = move.captured.has_value() ? piece_value(move.captured->type) : 0;
+            const int promotion = move.promoted.has_value() ? piece_value(move.promoted->type) : 0;
+            scored.order = capture_order + 10 * (victim + promotion) - piece_value(move.piece.type) / 100;
+        } else if (killers[0].matches(move)) {
+            scored.order = first_killer_order;
+        } else if (killers[1].matches(move)) {
+            scored.order = second_killer_order;
+        } else {
+            scored.order = history[move.from.index()][move.to.index()];
+        }
+    }
+}
+
+auto Worker::pick_move(MoveBuffer &buffer, std::size_t index) -> const Move & {
+    const auto first = buffer.moves.begin() + static_cast<std::ptrdiff_t>(index);
+    const auto last = buffer.moves.begin() + static_cast<std::ptrdiff_t>(buffer.size);
+    const auto best = std::max_element(first, last, [](const ScoredMove &lhs, const ScoredMove &rhs) { return lhs.order < rhs.order; });
+    std::iter_swap(first, best);
+    return first->move;
+}
+
+auto Worker::update_pv(int ply, const Move &move) -> void {
+    const auto current = static_cast<std::size_t>(ply);
+    auto &line = m_pv[current];
+    const auto &child = m_pv[current + 1];
+    line[current] = PackedMove{move};
+    const int child_length = m_pv_length[current + 1];
+    for (int index = ply + 1; index < child_length; ++index) {
+        line[static_cast<std::size_t>(index)] = child[static_cast<std::size_t>(index)];
+    }
+    m_pv_length[current] = std::max(child_length, ply + 1);
+}
+
+auto Worker::update_quiet_stats(const Move &move, int ply, int depth) -> void {
+    auto &killers = m_killers[static_cast<std::size_t>(ply)];
+    const PackedMove packed{move};
+    if (killers[0] != packed) {
+        killers[1] = killers[0];
+        killers[0] = packed;
+    }
+    auto &entry = m_history[get_index(move.piece.color)][move.from.index()][move.to.index()];
+    entry = std::min(entry + depth * depth, history_limit);
+}
+
+auto Worker::count_node() -> void {
+    ++m_unreported_nodes;
+    if (m_unreported_nodes < node_check_interval) {
+        return;
+    }
+    const auto nodes = m_shared.nodes.fetch_add(m_unreported_nodes, std::memory_order_relaxed) + m_unreported_nodes;
+    m_unreported_nodes = 0;
+    const auto &limits = m_shared.limits;
+    const bool node_limit_reached = limits.nodes != 0 && nodes >= limits.nodes;
+    const bool time_limit_reached = limits.time.count() != 0 && std::chrono::steady_clock::now() - m_shared.start >= limits.time;
+    if (node_limit_reached || time_limit_reached) {
+        m_shared.state.store(SearchState::Stopping, std::memory_order_relaxed);
+    }
+}
+
+// converts the packed moves of a variation into moves of the position
+auto unpack_line(Position position, const RootMove &root_move) -> MoveList {
+    // keep the moves out of the history of the caller
+    HashHistory history{};
+    position.attach_history(history);
+    MoveList line;
+    for (int index = 0; index < root_move.pv_length; ++index) {
+        const auto packed = root_move.pv[static_cast<std::size_t>(index)];
+        std::optional<Move> found{};
+        position.generate([&](const Move &move) {
+            if (packed.matches(move)) {
+                found = move;
+                return false;
+            }
+            return true;
+        });
+        if (!found.has_value()) {
+            break;
+        }
+        line.push_back(found.value());
+        position.make_move(found.value());
+    }
+    return line;
+}
+
+} // namespace
+
+auto evaluate(const Position &position) -> int {
+    const auto &board = position.board();
+    const bool endgame = board.bitmap(PieceType::Queen).empty();
+    int score{0};
+    for (const auto color : {Color::White, Color::Black}) {
+        int side_score{0};
+        for (const auto type : all_piece_types) {
+            const auto weight = type == PieceType::King && endgame ? endgame_king_centralization_weight : centralization_weight[get_index(type)];
+            for (const auto square : board.bitmap(Piece{.type = type, .color = color})) {
+                if (type != PieceType::King) {
+                    side_score += piece_value(type);
+                }
+                side_score += weight * centralization[square.index()];
+                if (type == PieceType::Pawn) {
+                    const auto rank = static_cast<std::size_t>(square.rank().rank - 1);
+                    side_score += pawn_advance_bonus[color == Color::White ? rank : 7 - rank];
+                }
+            }
+        }
+        score += color == Color::White ? side_score : -side_score;
+    }
+    return position.side_to_move() == Color::White ? score : -score;
+}
+
+auto Searcher::search(const Position &position, const Limits &limits) -> Result {
+    m_table.new_search();
+    m_state.store(SearchState::Searching, std::memory_order_relaxed);
+    SharedState shared{.table = m_table, .evaluator = m_evaluator, .state = m_state, .limits = limits, .start = std::chrono::steady_clock::now()};
+
+    const auto thread_count = static_cast<std::size_t>(std::max(limits.threads, 1));
+    std::vector<std::unique_ptr<Worker>> workers;
+    workers.reserve(thread_count);
+    for (std::size_t id = 0; id < thread_count; ++id) {
+        workers.push_back(std::make_unique<Worker>(shared, position, static_cast<int>(id)));
+    }
+    std::vector<std::thread> helpers;
+    helpers.reserve(thread_count - 1);
+    for (std::size_t id = 1; id < thread_count; ++id) {
+        helpers.emplace_back([&worker = *workers[id]] { worker.run(); });
+    }
+    workers.front()->run();
+    m_state.store(SearchState::Stopping, std::memory_order_relaxed);
+    for (auto &helper : helpers) {
+        helper.join();
+    }
+    m_state.store(SearchState::Idle, std::memory_order_relaxed);
+
+    Result result{};
+    result.nodes = shared.nodes.load(std::memory_order_relaxed);
+    const auto &main = *workers.front();
+    result.depth = main.completed_depth();
+    for (const auto &root_move : main.completed_lines()) {
+        result.lines.push_back(PvLine{.moves = unpack_line(position, root_move), .score = root_move.score});
+    }
+    if (!result.lines.empty()) {
+        result.best_move = main.completed_lines().front().move;
+        result.score = result.lines.front().score;
+        result.pv = result.lines.front().moves;
+    } else if (!position.checkers().empty()) {
+        result.score = -mate_score;
+    }
+    return result;
+}
+
+} // namespace chesscore::search
@@ -0,0 +1,312 @@
+/* ************************************************************************** *
+ * Chess Core                                                                 *
+ * Data structures and algorithms for chess                                   *
+ * ************************************************************************** */
+
+#include "chesscore/shared_hash_table.h"
+
+#include <bit>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <thread>
+#include <utility>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define CHESSCORE_POSIX_SHARED_MEMORY
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace chesscore {
+
+namespace {
+
+auto segment_name(const std::string &name) -> std::string {
+    return name.starts_with('/') ? name : "/" + name;
+}
+
+#if defined(CHESSCORE_POSIX_SHARED_MEMORY)
+
+// marks an initialized segment ("CCSHTBL" in ASCII)
+constexpr std::uint64_t segment_magic{0x004343534854424CULL};
+
+// how long to wait for another process to initialize the segment
+constexpr auto attach_timeout = std::chrono::seconds{2};
+constexpr auto attach_poll_interval = std::chrono::milliseconds{1};
+
+auto system_error(const std::string &action, const std::string &name) -> SharedMemoryError {
+    return SharedMemoryError{"Could not " + action + " shared memory '" + name + "': " + std::strerror(errno)};
+}
+
+// waits until the condition holds, or the attach timeout expired
+template<typename Condition>
+auto wait_for(Condition condition) -> bool {
+    const auto deadline = std::chrono::steady_clock::now() + attach_timeout;
+    while (!condition()) {
+        if (std::chrono::steady_clock::now() > deadline) {
+            return false;
+        }
+        std::this_thread::sleep_for(attach_poll_interval);
+    }
+    return true;
+}
+
+auto stale_segment_error(const std::string &name, std::int64_t creator = 0) -> SharedMemoryError {
+    const auto process = creator > 0 ? " (process " + std::to_string(creator) + ")" : std::string{};
+    return SharedMemoryError{"Shared memory '" + name + "' is not initialized by its creator" + process + "; remove it, if the creator hangs"};
+}
+
+// closes a descriptor when leaving the scope, which also releases its lock
+class DescriptorGuard {
+public:
+    explicit DescriptorGuard(int descriptor) : m_descriptor{descriptor} {}
+    DescriptorGuard(const DescriptorGuard &) = delete;
+    auto operator=(const DescriptorGuard &) -> DescriptorGuard & = delete;
+    ~DescriptorGuard() { close(m_descriptor); }
+private:
+    int m_descriptor;
+};
+
+// checks, if two descriptors refer to the same segment
+auto same_segment(int first, int second) -> bool {
+    struct stat first_status {};
+    struct stat second_status {};
+    return fstat(first, &first_status) == 0 && fstat(second, &second_status) == 0 && first_status.st_dev == second_status.st_dev && first_status.st_ino == second_status.st_ino;
+}
+
+// removes a segment that its creator left uninitialized; returns false, if the creator still holds
+// its lock. The lock also serializes the recovery: a process that waited for another one finds the
+// name removed or referring to a new segment, and leaves it alone.
+template<typename Condition>
+auto remove_stale_segment(int descriptor, const std::string &name, Condition initialized) -> bool {
+    if (!wait_for([&] { return flock(descriptor, LOCK_EX | LOCK_NB) == 0; })) {
+        return false;
+    }
+    if (!initialized()) {
+        const int current = shm_open(name.c_str(), O_RDWR, 0);
+        if (current >= 0) {
+            if (same_segment(descriptor, current)) {
+                shm_unlink(name.c_str());
+            }
+            close(current);
+        }
+    }
+    flock(descriptor, LOCK_UN);
+    return true;
+}
+
+#endif
+
+} // namespace
+
+#if defined(CHESSCORE_POSIX_SHARED_MEMORY)
+
+SharedHashTable::SharedHashTable(const std::string &name, std::size_t megabytes) : m_name{segment_name(name)} {
+    const std::size_t bucket_limit = megabytes * 1024 * 1024 / sizeof(Bucket);
+    if (bucket_limit == 0) {
+        throw SharedMemoryError{"Shared hash table '" + m_name + "' is too small"};
+    }
+    const auto bucket_count = std::bit_floor(bucket_limit);
+    // a stale segment was removed by the first attempt, so the second one creates it anew
+    if (!open_segment(bucket_count) && !open_segment(bucket_count)) {
+        throw stale_segment_error(m_name);
+    }
+}
+
+// creates or attaches to the segment; returns false, if the segment was removed while opening it
+auto SharedHashTable::open_segment(std::size_t bucket_count) -> bool {
+    m_bucket_count = bucket_count;
+    const auto expected_size = sizeof(Header) + m_bucket_count * sizeof(Bucket);
+    int descriptor = shm_open(m_name.c_str(), O_RDWR | O_CREAT | O_EXCL, S_IRUSR | S_IWUSR);
+    m_created = descriptor >= 0;
+    if (!m_created) {
+        if (errno != EEXIST) {
+            throw system_error("create", m_name);
+        }
+        descriptor = shm_open(m_name.c_str(), O_RDWR, 0);
+        if (descriptor < 0) {
+            if (errno == ENOENT) {
+                return false;
+            }
+            throw system_error("open", m_name);
+        }
+    }
+    const DescriptorGuard guard{descriptor};
+
+    if (m_created) {
+        // held until the segment is initialized; without support for locks, stale segments are not removed
+        flock(descriptor, LOCK_EX | LOCK_NB);
+        if (ftruncate(descriptor, static_cast<off_t>(expected_size)) != 0) {
+            const auto error = system_error("resize", m_name);
+            shm_unlink(m_name.c_str());
+            throw error;
+        }
+        m_mapping_size = expected_size;
+    } else {
+        struct stat status {};
+        const auto sized = [&] { return fstat(descriptor, &status) == 0 && status.st_size >= static_cast<off_t>(sizeof(Header)); };
+        if (!wait_for(sized)) {
+            // the creator did not even size the segment
+            if (!remove_stale_segment(descriptor, m_name, sized)) {
+                throw stale_segment_error(m_name);
+            }
+            return false;
+        }
+        m_mapping_size = static_cast<std::size_t>(status.st_size);
+    }
+
+    void *mapping = mmap(nullptr, m_mapping_size, PROT_READ | PROT_WRITE, MAP_SHARED, descriptor, 0);
+    if (mapping == MAP_FAILED) {
+        const auto error = system_error("map", m_name);
+        if (m_created) {
+            shm_unlink(m_name.c_str());
+        }
+        throw error;
+    }
+    m_mapping = mapping;
+
+    if (m_created) {
+        auto *header = new (m_mapping) Header{};
+        header->creator.store(getpid(), std::memory_order_relaxed);
+        header->version = format_version;
+        header->bucket_size = sizeof(Bucket);
+        header->bucket_count = m_bucket_count;
+        m_buckets = reinterpret_cast<Bucket *>(static_cast<std::byte *>(m_mapping) + sizeof(Header));
+        std::uninitialized_default_construct_n(m_buckets, m_bucket_count);
+        header->magic.store(segment_magic, std::memory_order_release);
+        return true;
+    }
+
+    const auto *header = static_cast<const Header *>(m_mapping);
+    const auto initialized = [&] { return header->magic.load(std::memory_order_acquire) == segment_magic; };
+    if (!wait_for(initialized)) {
+        const auto creator = header->creator.load(std::memory_order_relaxed);
+        const bool removed = remove_stale_segment(descriptor, m_name, initialized);
+        detach();
+        if (!removed) {
+            throw stale_segment_error(m_name, creator);
+        }
+        return false;
+    }
+    if (header->version != format_version || header->bucket_size != sizeof(Bucket) || header->bucket_count != m_bucket_count || m_mapping_size != expected_size) {
+        detach();
+        throw SharedMemoryError{"Shared hash table '" + m_name + "' has a different version or size"};
+    }
+    m_buckets = reinterpret_cast<Bucket *>(static_cast<std::byte *>(m_mapping) + sizeof(Header));
+    return true;
+}
+
+auto SharedHashTable::detach() -> void {
+    if (m_mapping != nullptr) {
+        munmap(m_mapping, m_mapping_size);
+    }
+    m_mapping = nullptr;
+    m_mapping_size = 0;
+    m_buckets = nullptr;
+    m_bucket_count = 0;
+}
+
+auto SharedHashTable::remove(const std::string &name) -> bool {
+    return shm_unlink(segment_name(name).c_str()) == 0;
+}
+
+#else
+
+SharedHashTable::SharedHashTable(const std::string &name, std::size_t /*megabytes*/) : m_name{segment_name(name)} {
+    throw SharedMemoryError{"Shared hash tables are not supported on this system"};
+}
+
+auto SharedHashTable::detach() -> void {
+    m_mapping = nullptr;
+    m_mapping_size = 0;
+    m_buckets = nullptr;
+    m_bucket_count = 0;
+}
+
+auto SharedHashTable::remove(const std::string & /*name*/) -> bool {
+    return false;
+}
+
+#endif
+
+SharedHashTable::SharedHashTable(SharedHashTable &&other) noexcept
+    : m_name{std::move(other.m_name)},
+      m_mapping{std::exchange(other.m_mapping, nullptr)},
+      m_mapping_size{std::exchange(other.m_mapping_size, 0)},
+      m_buckets{std::exchange(other.m_buckets, nullptr)},
+      m_bucket_count{std::exchange(other.m_bucket_count, 0)},
+      m_created{std::exchange(other.m_created, false)} {}
+
+auto SharedHashTable::operator=(SharedHashTable &&other) noexcept -> SharedHashTable & {
+    if (this != &other) {
+        detach();
+        m_name = std::move(other.m_name);
+        m_mapping = std::exchange(other.m_mapping, nullptr);
+        m_mapping_size = std::exchange(other.m_mapping_size, 0);
+        m_buckets = std::exchange(other.m_buckets, nullptr);
+        m_bucket_count = std::exchange(other.m_bucket_count, 0);
+        m_created = std::exchange(other.m_created, false);
+    }
+    return *this;
+}
+
+SharedHashTable::~SharedHashTable() {
+    detach();
+}
+
+auto SharedHashTable::probe(const ZobristHash &hash) const -> std::optional<std::uint64_t> {
+    if (m_buckets == nullptr) {
+        return std::nullopt;
+    }
+    for (const auto &entry : bucket(hash).entries) {
+        const auto value = entry.value.load(std::memory_order_relaxed);
+        const auto key = entry.key.load(std::memory_order_relaxed);
+        if ((key | value) != 0 && (key ^ value) == hash.hash()) {
+            return value;
+        }
+    }
+    return std::nullopt;
+}
+
+auto SharedHashTable::store(const ZobristHash &hash, std::uint64_t value) -> void {
+    if (m_buckets == nullptr) {
+        return;
+    }
+    auto &entries = bucket(hash).entries;
+    Entry *target = &entries[(hash.hash() >> 62U) % entries_per_bucket];
+    Entry *preferred{nullptr};
+    for (auto &entry : entries) {
+        const auto old_value = entry.value.load(std::memory_order_relaxed);
+        const auto old_key = entry.key.load(std::memory_order_relaxed);
+        if ((old_key | old_value) == 0) {
+            if (preferred == nullptr) {
+                preferred = &entry;
+            }
+        } else if ((old_key ^ old_value) == hash.hash()) {
+            preferred = &entry;
+            break;
+        }
+    }
+    if (preferred != nullptr) {
+        target = preferred;
+    }
+    target->key.store(hash.hash() ^ value, std::memory_order_relaxed);
+    target->value.store(value, std::memory_order_relaxed);
+}
+
+auto SharedHashTable::clear() -> void {
+    for (std::size_t index = 0; index < m_bucket_count; ++index) {
+        for (auto &entry : m_buckets[index].entries) {
+            entry.key.store(0, std::memory_order_relaxed);
+            entry.value.store(0, std::memory_order_relaxed);
+        }
+    }
+}
+
+} // namespace chesscore
@@ -0,0 +1,169 @@
+/* ************************************************************************** *
+ * Chess Core                                                                 *
+ * Data structures and algorithms for chess                                   *
+ * ************************************************************************** */
+
+#include "chesscore/transposition_table.h"
+
+#include <algorithm>
+#include <bit>
+#include <limits>
+#include <utility>
+
+namespace chesscore {
+
+namespace {
+
+// layout of the data word of an entry
+constexpr unsigned score_shift{16U};
+constexpr unsigned eval_shift{32U};
+constexpr unsigned depth_shift{48U};
+constexpr unsigned bound_shift{56U};
+constexpr unsigned generation_shift{58U};
+
+// weight of one generation of age against one ply of depth when replacing
+constexpr int age_weight{8};
+
+// number of buckets sampled by hashfull()
+constexpr std::size_t hashfull_sample_buckets{1000 / TranspositionTable::entries_per_bucket};
+
+} // namespace
+
+TranspositionTable::TranspositionTable(TranspositionTable &&other) noexcept
+    : m_memory{std::move(other.m_memory)},
+      m_buckets{std::exchange(other.m_buckets, nullptr)},
+      m_bucket_count{std::exchange(other.m_bucket_count, 0)},
+      m_generation{std::exchange(other.m_generation, 0)} {}
+
+auto TranspositionTable::operator=(TranspositionTable &&other) noexcept -> TranspositionTable & {
+    if (this != &other) {
+        m_memory = std::move(other.m_memory);
+        m_buckets = std::exchange(other.m_buckets, nullptr);
+        m_bucket_count = std::exchange(other.m_bucket_count, 0);
+        m_generation = std::exchange(other.m_generation, 0);
+    }
+    return *this;
+}
+
+auto TranspositionTable::resize(std::size_t megabytes) -> void {
+    const std::size_t bucket_limit = megabytes * 1024 * 1024 / sizeof(Bucket);
+    const std::size_t bucket_count = bucket_limit == 0 ? 0 : std::bit_floor(bucket_limit);
+    // release the old table first, so that both never need memory at the same time
+    m_buckets = nullptr;
+    m_bucket_count = 0;
+    m_memory = HugePageMemory{};
+    m_generation = 0;
+    // only the first huge page is touched to check the backing, the others are faulted in by the first probes
+    m_memory = HugePageMemory{bucket_count * sizeof(Bucket), HugePageOptions{.verify = true}};
+    // the memory is zeroed, so it already holds empty buckets (Bucket is an implicit-lifetime aggregate)
+    m_buckets = static_cast<Bucket *>(m_memory.data());
+    m_bucket_count = bucket_count;
+}
+
+auto TranspositionTable::clear() -> void {
+    for (std::size_t index = 0; index < m_bucket_count; ++index) {
+        for (auto &entry : m_buckets[index].entries) {
+            entry.key.store(0, std::memory_order_relaxed);
+            entry.data.store(0, std::memory_order_relaxed);
+        }
+    }
+    m_generation = 0;
+}
+
+auto TranspositionTable::probe(const ZobristHash &hash) const -> std::optional<TranspositionData> {
+    if (m_bucket_count == 0) {
+        return std::nullopt;
+    }
+    for (const auto &entry : bucket(hash).entries) {
+        const auto data = entry.data.load(std::memory_order_relaxed);
+        const auto key = entry.key.load(std::memory_order_relaxed);
+        if (data != 0 && (key ^ data) == hash.hash()) {
+            return unpack(data);
+        }
+    }
+    return std::nullopt;
+}
+
+auto TranspositionTable::store(const ZobristHash &hash, const TranspositionData &data) -> void {
+    if (m_bucket_count == 0) {
+        return;
+    }
+    Entry *replace{nullptr};
+    int replace_value{std::numeric_limits<int>::max()};
+    TranspositionData new_data{data};
+    for (auto &entry : bucket(hash).entries) {
+        const auto old = entry.data.load(std::memory_order_relaxed);
+        const auto key = entry.key.load(std::memory_order_relaxed);
+        if (old != 0 && (key ^ old) == hash.hash()) {
+            const auto old_data = unpack(old);
+            if (data.bound != Bound::Exact && data.depth + 4 <= old_data.depth && generation_of(old) == m_generation) {
+                return;
+            }
+            if (!new_data.move.has_value()) {
+                new_data.move = old_data.move;
+            }
+            replace = &entry;
+            break;
+        }
+        const int value = old == 0 ? std::numeric_limits<int>::min() : unpack(old).depth - age_weight * age(old);
+        if (value < replace_value) {
+            replace = &entry;
+            replace_value = value;
+        }
+    }
+    const auto packed = pack(new_data, m_generation);
+    replace->key.store(hash.hash() ^ packed, std::memory_order_relaxed);
+    replace->data.store(packed, std::memory_order_relaxed);
+}
+
+auto TranspositionTable::prefetch([[maybe_unused]] const ZobristHash &hash) const -> void {
+#if defined(__GNUC__)
+    if (m_bucket_count != 0) {
+        __builtin_prefetch(&bucket(hash));
+    }
+#endif
+}
+
+auto TranspositionTable::hashfull() const -> int {
+    const auto sample = std::min(m_bucket_count, hashfull_sample_buckets);
+    if (sample == 0) {
+        return 0;
+    }
+    std::size_t used{0};
+    for (std::size_t index = 0; index < sample; ++index) {
+        for (const auto &entry : m_buckets[index].entries) {
+            const auto data = entry.data.load(std::memory_order_relaxed);
+            if (data != 0 && generation_of(data) == m_generation) {
+                ++used;
+            }
+        }
+    }
+    return static_cast<int>(used * 1000 / (sample * entries_per_bucket));
+}
+
+auto TranspositionTable::pack(const TranspositionData &data, std::uint8_t generation) -> std::uint64_t {
+    return static_cast<std::uint64_t>(data.move.bits()) | (static_cast<std::uint64_t>(static_cast<std::uint16_t>(data.score)) << score_shift) |
+           (static_cast<std::uint64_t>(static_cast<std::uint16_t>(data.eval)) << eval_shift) |
+           (static_cast<std::uint64_t>(static_cast<std::uint8_t>(data.depth)) << depth_shift) | (static_cast<std::uint64_t>(data.bound) << bound_shift) |
+           (static_cast<std::uint64_t>(generation) << generation_shift);
+}
+
+auto TranspositionTable::unpack(std::uint64_t data) -> TranspositionData {
+    return TranspositionData{
+        .move = PackedMove::from_bits(static_cast<std::uint16_t>(data)),
+        .score = static_cast<std::int16_t>(static_cast<std::uint16_t>(data >> score_shift)),
+        .eval = static_cast<std::int16_t>(static_cast<std::uint16_t>(data >> eval_shift)),
+        .depth = static_cast<std::int8_t>(static_cast<std::uint8_t>(data >> depth_shift)),
+        .bound = static_cast<Bound>((data >> bound_shift) & 0x3U),
+    };
+}
+
+auto TranspositionTable::generation_of(std::uint64_t data) -> std::uint8_t {
+    return static_cast<std::uint8_t>(data >> generation_shift);
+}
+
+auto TranspositionTable::age(std::uint64_t data) const -> int {
+    return (generation_cycle + m_generation - generation_of(data)) & static_cast<int>(generation_mask);
+}
+
+} // namespace chesscore
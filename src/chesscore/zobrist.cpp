@@ -9,14 +9,6 @@
 
 namespace chesscore {
 
-bool ZobristKeys::m_initialized{false};
-std::array<ZobristKeys::key_t, 2 * piece_type_count * Square::count> ZobristKeys::m_piece_keys{};
-std::array<ZobristKeys::key_t, 16> ZobristKeys::m_castling_keys;
-std::array<ZobristKeys::key_t, Rank::max_rank> ZobristKeys::m_enpassant_keys;
-ZobristKeys::key_t ZobristKeys::m_side_key;
-
-std::optional<ZobristHash::key_t> ZobristHash::m_starting_position_hash{std::nullopt};
-
 auto ZobristHash::from_position(const Position &position) -> ZobristHash {
     ZobristHash hash{};
     if (position.side_to_move() == Color::Black) {
@@ -38,12 +30,9 @@ auto ZobristHash::from_position(const Position &position) -> ZobristHash {
 }
 
 auto ZobristHash::starting_position_hash() -> ZobristHash {
-    if (!m_starting_position_hash.has_value()) {
-        ZobristHash hash{};
-        const auto starting_position = Position{FenString::starting_position()};
-        m_starting_position_hash = ZobristHash::from_position(starting_position).hash();
-    }
-    return ZobristHash{m_starting_position_hash.value()};
+    // initialization of function-local statics is thread-safe
+    static const ZobristHash starting_hash = ZobristHash::from_position(Position{FenString::starting_position()});
+    return starting_hash;
 }
 
 } // namespace chesscore
@@ -206,3 +206,72 @@ TEST_CASE("Bitboard.Bitboard.IsAttacked.ByBlack", "[Bitboard][Attacks]") {
     CHECK_FALSE(board.is_attacked(Square::H3, Color::Black));
     CHECK_FALSE(board.is_attacked(Square::H8, Color::Black));
 }
+
+TEST_CASE("Bitboard.Bitboard.AttackersTo", "[Bitboard][Attacks]") {
+    const Bitboard board{FenString{"3r4/2k5/8/3p4/4P3/2N5/3R4/3Q2K1 w - - 0 1"}};
+
+    const auto attackers = board.attackers_to(Square::D5);
+    CHECK(attackers == (Bitmap{Square::E4} | Bitmap{Square::C3} | Bitmap{Square::D2} | Bitmap{Square::D8}));
+    CHECK((attackers & board.bitmap(Color::White)) == (Bitmap{Square::E4} | Bitmap{Square::C3} | Bitmap{Square::D2}));
+    CHECK(board.attackers_to(Square::E4) == (Bitmap{Square::D5} | Bitmap{Square::C3}));
+    CHECK(board.attackers_to(Square::H6).empty());
+
+    // removing the rook from d2 reveals the queen behind it
+    auto occupancy = board.occupied();
+    occupancy.clear(Square::D2);
+    CHECK((board.attackers_to(Square::D5, occupancy) & occupancy) == (Bitmap{Square::E4} | Bitmap{Square::C3} | Bitmap{Square::D1} | Bitmap{Square::D8}));
+}
+
+TEST_CASE("Bitboard.Bitboard.Pins", "[Bitboard][Attacks]") {
+    const Bitboard board{FenString{"4k3/4r3/8/b7/8/2N5/4B3/4K3 w - - 0 1"}};
+
+    CHECK(board.pinned_pieces(Square::E1, Color::White) == (Bitmap{Square::C3} | Bitmap{Square::E2}));
+    CHECK(board.pinners(Square::E1, Color::White) == (Bitmap{Square::A5} | Bitmap{Square::E7}));
+    CHECK(board.pinned_pieces(Square::E8, Color::Black).empty());
+    CHECK(board.pinners(Square::E8, Color::Black).empty());
+    // the bishop on e2 also shields the white king from the rook on e7
+    CHECK(board.slider_blockers(Square::E1, Color::Black) == (Bitmap{Square::C3} | Bitmap{Square::E2}));
+
+    // two pieces between king and slider do not pin
+    const Bitboard double_blocked{FenString{"4k3/4r3/4p3/8/8/8/4B3/4K3 w - - 0 1"}};
+    CHECK(double_blocked.pinned_pieces(Square::E1, Color::White).empty());
+}
+
+TEST_CASE("Bitboard.Bitboard.Discovered Check Candidates", "[Bitboard][Attacks]") {
+    const Bitboard board{FenString{"4k3/8/8/1B6/4N3/8/8/4R1K1 w - - 0 1"}};
+    CHECK(board.discovered_check_candidates(Color::White) == Bitmap{Square::E4});
+    CHECK(board.discovered_check_candidates(Color::Black).empty());
+}
+
+TEST_CASE("Bitboard.Bitboard.XRay Attacks", "[Bitboard][Attacks]") {
+    const Bitboard board{FenString{"4k3/8/8/1B6/4N3/8/8/4R1K1 w - - 0 1"}};
+    CHECK(board.xray_attacks(Square::E1, PieceType::Rook, Square::E4) == (Bitmap{Square::E5} | Bitmap{Square::E6} | Bitmap{Square::E7} | Bitmap{Square::E8}));
+    CHECK(board.xray_attacks(Square::E1, PieceType::Bishop, Square::E4).empty());
+    CHECK(board.xray_attacks(Square::B5, PieceType::Bishop, Square::E8).empty());
+}
+
+TEST_CASE("Bitboard.Bitboard.Attacks", "[Bitboard][Attacks]") {
+    const Bitboard board{FenString::starting_position()};
+    CHECK(board.attacks(Piece::WhiteKnight, Square::B1) == (Bitmap{Square::A3} | Bitmap{Square::C3} | Bitmap{Square::D2}));
+    CHECK(board.attacks(Piece::WhiteRook, Square::A1) == (Bitmap{Square::A2} | Bitmap{Square::B1}));
+    CHECK(board.attacks(Piece::BlackPawn, Square::E7) == (Bitmap{Square::D6} | Bitmap{Square::F6}));
+    CHECK(board.attacks_by(Piece::WhitePawn) == Bitmap{0x0000000000FF0000ULL});
+    CHECK(board.attacks_by(Color::White) == Bitmap{0x0000000000FFFF7EULL});
+    CHECK(board.attacks_by(Color::Black) == Bitmap{0x7EFFFF0000000000ULL});
+
+    const Bitboard open_board{FenString{"4k3/8/8/3p4/3Q4/8/8/4K3 w - - 0 1"}};
+    CHECK(open_board.attacks(Piece::WhiteQueen, Square::D4).count() == 24);
+    CHECK(open_board.attacks(Piece::WhiteQueen, Square::D4).get(Square::D5));
+    CHECK_FALSE(open_board.attacks(Piece::WhiteQueen, Square::D4).get(Square::D6));
+}
+
+TEST_CASE("Bitboard.Bitboard.Mobility", "[Bitboard][Attacks]") {
+    const Bitboard board{FenString::starting_position()};
+    CHECK(board.mobility(Piece::WhiteKnight, ~board.bitmap(Color::White)) == 4);
+    CHECK(board.mobility(Piece::WhiteBishop, ~board.bitmap(Color::White)) == 0);
+
+    const Bitboard open_board{FenString{"4k3/8/2p5/8/3Q4/8/5P2/4K3 w - - 0 1"}};
+    const auto safe = ~open_board.bitmap(Color::White) & ~open_board.attacks_by(Piece::BlackPawn);
+    // the queen attacks 26 squares, f2 holds an own pawn and d5 is covered by the c6 pawn
+    CHECK(open_board.mobility(Piece::WhiteQueen, safe) == 24);
+}
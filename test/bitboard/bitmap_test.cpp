@@ -3,6 +3,8 @@
  * Data structures and algorithms for chess                                   *
  * ************************************************************************** */
 
+#include <vector>
+
 #include <catch2/catch_all.hpp>
 
 #include "chesscore/bitmap.h"
@@ -141,3 +143,35 @@ TEST_CASE("Bitboard.Bitmap.Shift operators", "[Bitmap][Operators]") {
     bitmap2 = bitmap >> 1;
     CHECK(bitmap2.bits() == 0x08'01'00'40'20'38'7F'80ULL);
 }
+
+TEST_CASE("Bitboard.Bitmap.Lowest and highest square", "[Bitmap][Scan]") {
+    Bitmap bitmap{};
+    bitmap.set(Square::C2);
+    bitmap.set(Square::F7);
+    bitmap.set(Square::B5);
+    CHECK(bitmap.lsb() == Square::C2);
+    CHECK(bitmap.msb() == Square::F7);
+    CHECK(Bitmap{Square::A1}.lsb() == Square::A1);
+    CHECK(Bitmap{Square::H8}.msb() == Square::H8);
+
+    CHECK(bitmap.pop_lsb() == Square::C2);
+    CHECK(bitmap.pop_lsb() == Square::B5);
+    CHECK(bitmap.count() == 1);
+    CHECK(bitmap.pop_lsb() == Square::F7);
+    CHECK(bitmap.empty());
+}
+
+TEST_CASE("Bitboard.Bitmap.Square iteration", "[Bitmap][Scan]") {
+    CHECK(Bitmap{}.begin() == Bitmap{}.end());
+
+    Bitmap bitmap{};
+    bitmap.set(Square::H8);
+    bitmap.set(Square::A1);
+    bitmap.set(Square::D4);
+    std::vector<Square> squares{};
+    for (const auto square : bitmap) {
+        squares.push_back(square);
+    }
+    CHECK(squares == std::vector<Square>{Square::A1, Square::D4, Square::H8});
+    CHECK(bitmap.count() == 3);
+}
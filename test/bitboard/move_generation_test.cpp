@@ -365,3 +365,27 @@ TEST_CASE("Bitboard.Bitboard.MoveGeneration.Check After Move", "[Bitboard][MoveG
     CHECK_FALSE(move_list_contains(moves1, Move{Square::G1, Square::F1, Piece::WhiteKing}));
     CHECK_FALSE(move_list_contains(moves1, Move{Square::G1, Square::F2, Piece::WhiteKing}));
 }
+
+TEST_CASE("Bitboard.Bitboard.MoveGeneration.Visitor", "[Bitboard][MoveGeneration]") {
+    const Position position{FenString{"r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1"}};
+    const auto moves = position.all_legal_moves();
+
+    MoveList visited{};
+    CHECK(position.board().generate(position.state(), [&visited](const Move &move) { visited.push_back(move); }));
+    CHECK(visited == moves);
+
+    int count{0};
+    CHECK(position.generate([&count](const Move &) { ++count; }));
+    CHECK(count == 48);
+}
+
+TEST_CASE("Bitboard.Bitboard.MoveGeneration.Visitor Stops", "[Bitboard][MoveGeneration]") {
+    const Position position{FenString::starting_position()};
+    int count{0};
+    const auto completed = position.generate([&count](const Move &) {
+        ++count;
+        return count < 3;
+    });
+    CHECK_FALSE(completed);
+    CHECK(count == 3);
+}
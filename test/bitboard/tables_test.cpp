@@ -0,0 +1,60 @@
+/* ************************************************************************** *
+ * Chess Core                                                                 *
+ * Data structures and algorithms for chess                                   *
+ * ************************************************************************** */
+
+#include <catch2/catch_all.hpp>
+
+#include "chesscore/bitboard_tables.h"
+
+using namespace chesscore;
+using namespace chesscore::bitmaps;
+
+TEST_CASE("Bitboard.Tables.Targets", "[Tables]") {
+    CHECK(knight_target_table[Square::A1] == (Bitmap{Square::B3} | Bitmap{Square::C2}));
+    CHECK(knight_target_table[Square::D4].count() == 8);
+    CHECK(king_target_table[Square::H8] == (Bitmap{Square::G8} | Bitmap{Square::G7} | Bitmap{Square::H7}));
+    CHECK(king_target_table[Square::E4].count() == 8);
+    CHECK(rook_target_table[Square::D4].count() == 14);
+    CHECK(bishop_target_table[Square::A1] == Bitmap{0x8040201008040200ULL});
+    CHECK(queen_target_table[Square::D4] == (rook_target_table[Square::D4] | bishop_target_table[Square::D4]));
+    CHECK(ray_target_table[RayDirection::North][Square::E6] == (Bitmap{Square::E7} | Bitmap{Square::E8}));
+    CHECK(ray_target_table[RayDirection::SouthWest][Square::C3] == (Bitmap{Square::B2} | Bitmap{Square::A1}));
+    CHECK(ray_target_table[RayDirection::West][Square::A5].empty());
+}
+
+TEST_CASE("Bitboard.Tables.Ranks and Files", "[Tables]") {
+    for (int rank = Rank::min_rank; rank <= Rank::max_rank; ++rank) {
+        CHECK(rank_table[Rank{rank}] == Bitmap{0xFFULL << (8 * (rank - 1))});
+    }
+    for (int file = File::min_file; file <= File::max_file; ++file) {
+        CHECK(file_table[File{file}] == Bitmap{0x0101010101010101ULL << (file - 1)});
+    }
+}
+
+TEST_CASE("Bitboard.Tables.Between", "[Tables]") {
+    CHECK(between(Square::A1, Square::D4) == (Bitmap{Square::B2} | Bitmap{Square::C3}));
+    CHECK(between(Square::D4, Square::A1) == (Bitmap{Square::B2} | Bitmap{Square::C3}));
+    CHECK(between(Square::E1, Square::E8).count() == 6);
+    CHECK(between(Square::B5, Square::G5) == (Bitmap{Square::C5} | Bitmap{Square::D5} | Bitmap{Square::E5} | Bitmap{Square::F5}));
+    CHECK(between(Square::E1, Square::E2).empty());
+    CHECK(between(Square::A1, Square::B3).empty());
+    CHECK(between(Square::C3, Square::C3).empty());
+}
+
+TEST_CASE("Bitboard.Tables.Line", "[Tables]") {
+    CHECK(line(Square::C3, Square::E5) == (bishop_target_table[Square::A1] | Bitmap{Square::A1}));
+    CHECK(line(Square::E5, Square::C3) == line(Square::C3, Square::E5));
+    CHECK(line(Square::E2, Square::E7) == file_table[File{'e'}]);
+    CHECK(line(Square::A4, Square::B4) == rank_table[Rank{4}]);
+    CHECK(line(Square::A1, Square::B3).empty());
+    CHECK(line(Square::C3, Square::C3).empty());
+}
+
+TEST_CASE("Bitboard.Tables.Distance", "[Tables]") {
+    CHECK(distance(Square::A1, Square::A1) == 0);
+    CHECK(distance(Square::A1, Square::H8) == 7);
+    CHECK(distance(Square::B1, Square::C3) == 2);
+    CHECK(distance(Square::E4, Square::D5) == 1);
+    CHECK(distance(Square::H1, Square::A2) == 7);
+}
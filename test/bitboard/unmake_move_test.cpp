@@ -37,6 +37,28 @@ TEST_CASE("Bitboard.Bitboard.UnmakeMove.Capture", "[Bitboard][UnmakeMove]") {
     CHECK(board.get_piece(Square::C4) == Piece::WhiteBishop);
 }
 
+TEST_CASE("Bitboard.Bitboard.UnmakeMove.Capture Promotion", "[Bitboard][UnmakeMove]") {
+    const FenString fen{"1r2k3/P7/8/8/8/8/8/4K3 w - - 0 1"};
+    Bitboard board{fen};
+
+    Move m{
+        .from = Square::A7,
+        .to = Square::B8,
+        .piece = Piece::WhitePawn,
+        .captured{Piece::BlackRook},
+        .promoted{Piece::WhiteRook},
+        .castling_rights_before{CastlingRights::none()},
+        .halfmove_clock_before = 0
+    };
+    board.make_move(m);
+    CHECK_FALSE(board.get_piece(Square::A7).has_value());
+    CHECK(board.get_piece(Square::B8) == Piece::WhiteRook);
+    CHECK(board.piece_count(Piece::BlackRook) == 0);
+
+    board.unmake_move(m);
+    CHECK(board == Bitboard{fen});
+}
+
 TEST_CASE("Bitboard.Bitboard.UnmakeMove.EnPassant", "[Bitboard][UnmakeMove]") {
     Bitboard board{FenString{"8/8/8/8/4Pp2/8/8/8 b - e3 0 1"}};
 
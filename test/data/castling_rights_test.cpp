@@ -0,0 +1,47 @@
+/* ************************************************************************** *
+ * Chess Core                                                                 *
+ * Data structures and algorithms for chess                                   *
+ * ************************************************************************** */
+
+#include <catch2/catch_all.hpp>
+
+#include "chesscore/position_types.h"
+
+using namespace chesscore;
+
+TEST_CASE("Data.CastlingRights.Mask", "[castling]") {
+    CHECK(CastlingRights::none().mask() == 0);
+    CHECK(CastlingRights::all().mask() == CastlingRights::AllRights);
+    const CastlingRights rights{true, false, false, true};
+    CHECK(rights.white_kingside());
+    CHECK_FALSE(rights.white_queenside());
+    CHECK_FALSE(rights.black_kingside());
+    CHECK(rights.black_queenside());
+    CHECK(rights == CastlingRights{static_cast<std::uint8_t>(CastlingRights::WhiteKingside | CastlingRights::BlackQueenside)});
+    CHECK(rights['K']);
+    CHECK_FALSE(rights['k']);
+    CHECK_THROWS_AS(rights['x'], OutOfRange);
+}
+
+TEST_CASE("Data.CastlingRights.Set", "[castling]") {
+    CastlingRights rights{};
+    rights.set(CastlingRights::WhiteQueenside);
+    CHECK(rights.white_queenside());
+    rights.set(CastlingRights::WhiteQueenside, false);
+    CHECK(rights == CastlingRights::none());
+}
+
+TEST_CASE("Data.CastlingRights.Preserved By Square", "[castling]") {
+    auto after_move = [](const Square &from, const Square &to) {
+        auto rights = CastlingRights::all();
+        rights.keep(CastlingRights::preserved_by(from) & CastlingRights::preserved_by(to));
+        return rights;
+    };
+    CHECK(after_move(Square::E2, Square::E4) == CastlingRights::all());
+    CHECK(after_move(Square::E1, Square::F1) == CastlingRights{false, false, true, true});
+    CHECK(after_move(Square::H1, Square::H5) == CastlingRights{false, true, true, true});
+    CHECK(after_move(Square::A1, Square::A5) == CastlingRights{true, false, true, true});
+    CHECK(after_move(Square::E8, Square::D8) == CastlingRights{true, true, false, false});
+    CHECK(after_move(Square::B2, Square::H8) == CastlingRights{true, true, false, true});
+    CHECK(after_move(Square::A8, Square::A1) == CastlingRights{true, false, true, false});
+}
@@ -3,6 +3,8 @@
  * Data structures and algorithms for chess                                   *
  * ************************************************************************** */
 
+#include <optional>
+
 #include <catch2/catch_all.hpp>
 
 #include "chesscore/square.h"
@@ -192,3 +194,28 @@ TEST_CASE("Data.Coords.Square mirroring", "[Square]") {
     CHECK(Square::D7.mirrored() == Square{File{'d'}, Rank{2}});
     CHECK(Square::B8.mirrored() == Square{File{'b'}, Rank{1}});
 }
+
+TEST_CASE("Data.Coords.Packed Square", "[Square]") {
+    STATIC_REQUIRE(sizeof(PackedSquare) == 1);
+    PackedSquare packed{};
+    CHECK_FALSE(packed.has_value());
+    CHECK_THROWS_AS(packed.value(), std::bad_optional_access);
+    packed = Square::E3;
+    REQUIRE(packed.has_value());
+    CHECK(packed.value() == Square::E3);
+    CHECK(static_cast<std::optional<Square>>(packed) == Square::E3);
+    packed.reset();
+    CHECK(static_cast<std::optional<Square>>(packed) == std::nullopt);
+    CHECK(PackedSquare{std::optional<Square>{Square::H8}} == PackedSquare{Square::H8});
+    CHECK(PackedSquare{std::optional<Square>{}} == PackedSquare{});
+}
+
+TEST_CASE("Data.Coords.Square from index", "[Square]") {
+    for (std::size_t index = 0; index < Square::count; ++index) {
+        CHECK(Square::from_index(index).index() == index);
+    }
+    CHECK(Square::from_index(0) == Square::A1);
+    CHECK(Square::from_index(27) == Square::D4);
+    CHECK(Square::from_index(63) == Square::H8);
+    CHECK_THROWS_AS(Square::from_index(64), OutOfRange);
+}
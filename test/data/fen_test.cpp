@@ -193,38 +193,38 @@ TEST_CASE("Data.FEN.Write.Castling Availability", "[FENString][Write]") {
     CHECK(detail::castling_rights_to_string(CastlingRights::none()) == "-");
     CHECK(detail::castling_rights_to_string(CastlingRights::all()) == "KQkq");
     CastlingRights rights = CastlingRights::none();
-    rights.white_kingside = true;
+    rights.set(CastlingRights::WhiteKingside, true);
     CHECK(detail::castling_rights_to_string(rights) == "K");
     rights = CastlingRights::none();
-    rights.white_queenside = true;
+    rights.set(CastlingRights::WhiteQueenside, true);
     CHECK(detail::castling_rights_to_string(rights) == "Q");
     rights = CastlingRights::none();
-    rights.black_kingside = true;
+    rights.set(CastlingRights::BlackKingside, true);
     CHECK(detail::castling_rights_to_string(rights) == "k");
     rights = CastlingRights::none();
-    rights.black_queenside = true;
+    rights.set(CastlingRights::BlackQueenside, true);
     CHECK(detail::castling_rights_to_string(rights) == "q");
     rights = CastlingRights::none();
-    rights.white_kingside = true;
-    rights.white_queenside = true;
+    rights.set(CastlingRights::WhiteKingside, true);
+    rights.set(CastlingRights::WhiteQueenside, true);
     CHECK(detail::castling_rights_to_string(rights) == "KQ");
     rights = CastlingRights::none();
-    rights.black_kingside = true;
-    rights.black_queenside = true;
+    rights.set(CastlingRights::BlackKingside, true);
+    rights.set(CastlingRights::BlackQueenside, true);
     CHECK(detail::castling_rights_to_string(rights) == "kq");
     rights = CastlingRights::none();
-    rights.white_kingside = true;
-    rights.black_kingside = true;
+    rights.set(CastlingRights::WhiteKingside, true);
+    rights.set(CastlingRights::BlackKingside, true);
     CHECK(detail::castling_rights_to_string(rights) == "Kk");
     rights = CastlingRights::none();
-    rights.white_queenside = true;
-    rights.black_queenside = true;
+    rights.set(CastlingRights::WhiteQueenside, true);
+    rights.set(CastlingRights::BlackQueenside, true);
     CHECK(detail::castling_rights_to_string(rights) == "Qq");
     rights = CastlingRights::none();
-    rights.white_kingside = true;
-    rights.black_kingside = false;
-    rights.white_queenside = true;
-    rights.black_queenside = true;
+    rights.set(CastlingRights::WhiteKingside, true);
+    rights.set(CastlingRights::BlackKingside, false);
+    rights.set(CastlingRights::WhiteQueenside, true);
+    rights.set(CastlingRights::BlackQueenside, true);
     CHECK(detail::castling_rights_to_string(rights) == "KQq");
 }
 
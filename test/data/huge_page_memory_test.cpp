@@ -0,0 +1,74 @@
+/* ************************************************************************** *
+ * Chess Core                                                                 *
+ * Data structures and algorithms for chess                                   *
+ * ************************************************************************** */
+
+#include <catch2/catch_all.hpp>
+
+#include "chesscore/huge_page_memory.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <span>
+#include <utility>
+
+using namespace chesscore;
+
+TEST_CASE("Data.HugePageMemory.Empty", "[HugePageMemory]") {
+    const HugePageMemory memory{};
+    CHECK(memory.data() == nullptr);
+    CHECK(memory.size() == 0);
+    CHECK_FALSE(memory.huge_pages());
+
+    const HugePageMemory zero_size{0};
+    CHECK(zero_size.data() == nullptr);
+    CHECK(zero_size.page_kind() == PageKind::Regular);
+}
+
+TEST_CASE("Data.HugePageMemory.Allocation", "[HugePageMemory]") {
+    constexpr std::size_t size{HugePageMemory::huge_page_size + 100};
+    HugePageMemory memory{size};
+    REQUIRE(memory.data() != nullptr);
+    CHECK(memory.size() == size);
+    CHECK(reinterpret_cast<std::uintptr_t>(memory.data()) % 64 == 0);
+    if (memory.huge_pages()) {
+        CHECK(reinterpret_cast<std::uintptr_t>(memory.data()) % HugePageMemory::huge_page_size == 0);
+    }
+
+    const std::span bytes{static_cast<std::uint8_t *>(memory.data()), memory.size()};
+    CHECK(std::ranges::all_of(bytes, [](std::uint8_t byte) { return byte == 0; }));
+    std::ranges::fill(bytes, std::uint8_t{0xAB});
+    CHECK(bytes.back() == 0xAB);
+}
+
+TEST_CASE("Data.HugePageMemory.Options", "[HugePageMemory]") {
+    constexpr std::size_t size{2 * HugePageMemory::huge_page_size};
+    const HugePageMemory unchecked{size};
+    CHECK(unchecked.page_kind() != PageKind::Transparent);
+
+    const HugePageMemory verified{size, HugePageOptions{.verify = true}};
+    CHECK(verified.page_kind() != PageKind::Advised);
+    CHECK(verified.huge_pages() == (verified.page_kind() != PageKind::Regular));
+
+    const HugePageMemory prefaulted{size, HugePageOptions{.prefault = true, .verify = true}};
+    REQUIRE(prefaulted.data() != nullptr);
+    CHECK(prefaulted.page_kind() != PageKind::Advised);
+    const std::span bytes{static_cast<const std::uint8_t *>(prefaulted.data()), prefaulted.size()};
+    CHECK(std::ranges::all_of(bytes, [](std::uint8_t byte) { return byte == 0; }));
+}
+
+TEST_CASE("Data.HugePageMemory.Move", "[HugePageMemory]") {
+    HugePageMemory memory{4096};
+    void *data = memory.data();
+    const auto page_kind = memory.page_kind();
+
+    HugePageMemory moved{std::move(memory)};
+    CHECK(moved.data() == data);
+    CHECK(moved.size() == 4096);
+    CHECK(moved.page_kind() == page_kind);
+
+    HugePageMemory assigned{1024};
+    assigned = std::move(moved);
+    CHECK(assigned.data() == data);
+    CHECK(assigned.size() == 4096);
+}
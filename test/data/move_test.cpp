@@ -63,3 +63,28 @@ TEST_CASE("Data.Move.Comparison", "[Move][Compare]") {
     m2.en_passant_target_before = Square::G2;
     CHECK(is_moving_same_piece(m1, m2));
 }
+
+TEST_CASE("Data.Move.Packed Move", "[Move][Packed]") {
+    const Move move{.from = Square::E2, .to = Square::E4, .piece = Piece::WhitePawn};
+    const PackedMove packed{move};
+    CHECK(packed.has_value());
+    CHECK(packed.from() == Square::E2);
+    CHECK(packed.to() == Square::E4);
+    CHECK_FALSE(packed.promotion().has_value());
+    CHECK(packed.matches(move));
+    CHECK(PackedMove::from_bits(packed.bits()) == packed);
+    CHECK_FALSE(packed.matches(Move{.from = Square::E2, .to = Square::E3, .piece = Piece::WhitePawn}));
+
+    const Move promotion{.from = Square::B7, .to = Square::A8, .piece = Piece::WhitePawn, .captured = Piece::BlackRook, .promoted = Piece::WhiteKnight};
+    const PackedMove packed_promotion{promotion};
+    CHECK(packed_promotion.from() == Square::B7);
+    CHECK(packed_promotion.to() == Square::A8);
+    CHECK(packed_promotion.promotion() == PieceType::Knight);
+    CHECK(packed_promotion.matches(promotion));
+    CHECK_FALSE(packed_promotion.matches(Move{.from = Square::B7, .to = Square::A8, .piece = Piece::WhitePawn, .promoted = Piece::WhiteQueen}));
+
+    const PackedMove empty{};
+    CHECK_FALSE(empty.has_value());
+    CHECK(empty.bits() == 0);
+    CHECK_FALSE(empty.matches(Move{.from = Square::A1, .to = Square::A1}));
+}
@@ -0,0 +1,177 @@
+/* ************************************************************************** *
+ * Chess Core                                                                 *
+ * Data structures and algorithms for chess                                   *
+ * ************************************************************************** */
+
+#include <catch2/catch_all.hpp>
+
+#include "chesscore/perft.h"
+#include "chesscore/position.h"
+#include "chesscore/shared_hash_table.h"
+
+#include <array>
+#include <cstdint>
+#include <string>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+using namespace chesscore;
+
+namespace {
+
+auto unique_segment_name(const std::string &test) -> std::string {
+    return "/chesscore_test_" + test + "_" + std::to_string(getpid());
+}
+
+} // namespace
+
+TEST_CASE("Data.SharedHashTable.Create and Attach", "[SharedHashTable]") {
+    const auto name = unique_segment_name("attach");
+    SharedHashTable::remove(name);
+
+    SharedHashTable table{name, 1};
+    CHECK(table.attached());
+    CHECK(table.created());
+    CHECK(table.name() == name);
+    CHECK(table.bucket_count() == 1024 * 1024 / 64);
+
+    const auto position = Position::start_position();
+    CHECK_FALSE(table.probe(position.hash()).has_value());
+    table.store(position.hash(), 20);
+    CHECK(table.probe(position.hash()) == 20U);
+
+    SharedHashTable attached{name.substr(1), 1};
+    CHECK_FALSE(attached.created());
+    CHECK(attached.probe(position.hash()) == 20U);
+    attached.store(position.hash(), 400);
+    CHECK(table.probe(position.hash()) == 400U);
+
+    CHECK_THROWS_AS((SharedHashTable{name, 2}), SharedMemoryError);
+
+    attached.detach();
+    CHECK_FALSE(attached.attached());
+    CHECK_FALSE(attached.probe(position.hash()).has_value());
+    CHECK(table.probe(position.hash()) == 400U);
+
+    table.clear();
+    CHECK_FALSE(table.probe(position.hash()).has_value());
+    CHECK(SharedHashTable::remove(name));
+    CHECK_FALSE(SharedHashTable::remove(name));
+}
+
+TEST_CASE("Data.SharedHashTable.Stale Segment", "[SharedHashTable]") {
+    const auto name = unique_segment_name("stale");
+    SharedHashTable::remove(name);
+    // a creator that died after sizing the segment, but before initializing it
+    const int descriptor = shm_open(name.c_str(), O_RDWR | O_CREAT | O_EXCL, S_IRUSR | S_IWUSR);
+    REQUIRE(descriptor >= 0);
+    CHECK(ftruncate(descriptor, 1024 * 1024 + 64) == 0);
+    close(descriptor);
+
+    SharedHashTable table{name, 1};
+    CHECK(table.created());
+    table.store(ZobristHash{42}, 7);
+    CHECK(table.probe(ZobristHash{42}) == 7U);
+    SharedHashTable::remove(name);
+}
+
+TEST_CASE("Data.SharedHashTable.Creator Alive", "[SharedHashTable]") {
+    const auto name = unique_segment_name("alive");
+    SharedHashTable::remove(name);
+    // a creator that hangs while it holds the lock of the segment
+    const int descriptor = shm_open(name.c_str(), O_RDWR | O_CREAT | O_EXCL, S_IRUSR | S_IWUSR);
+    REQUIRE(descriptor >= 0);
+    REQUIRE(flock(descriptor, LOCK_EX | LOCK_NB) == 0);
+    CHECK_THROWS_AS((SharedHashTable{name, 1}), SharedMemoryError);
+
+    CHECK(ftruncate(descriptor, 1024 * 1024 + 64) == 0);
+    CHECK_THROWS_AS((SharedHashTable{name, 1}), SharedMemoryError);
+
+    // the lock is released, when the creator dies
+    close(descriptor);
+    SharedHashTable table{name, 1};
+    CHECK(table.created());
+    SharedHashTable::remove(name);
+}
+
+TEST_CASE("Data.SharedHashTable.Concurrent Recovery", "[SharedHashTable]") {
+    const auto name = unique_segment_name("recovery");
+    SharedHashTable::remove(name);
+    const int descriptor = shm_open(name.c_str(), O_RDWR | O_CREAT | O_EXCL, S_IRUSR | S_IWUSR);
+    REQUIRE(descriptor >= 0);
+    CHECK(ftruncate(descriptor, 1024 * 1024 + 64) == 0);
+    close(descriptor);
+
+    // both processes find the stale segment, but only one of them replaces it
+    std::array<pid_t, 2> children{};
+    for (std::size_t index = 0; index < children.size(); ++index) {
+        children[index] = fork();
+        REQUIRE(children[index] >= 0);
+        if (children[index] == 0) {
+            try {
+                SharedHashTable shared{name, 1};
+                shared.store(ZobristHash{index + 1}, index + 10);
+                _exit(0);
+            } catch (const SharedMemoryError &) {
+                _exit(1);
+            }
+        }
+    }
+    for (const auto child : children) {
+        int status{0};
+        REQUIRE(waitpid(child, &status, 0) == child);
+        CHECK(WIFEXITED(status));
+        CHECK(WEXITSTATUS(status) == 0);
+    }
+    SharedHashTable table{name, 1};
+    CHECK_FALSE(table.created());
+    CHECK(table.probe(ZobristHash{1}) == 10U);
+    CHECK(table.probe(ZobristHash{2}) == 11U);
+    SharedHashTable::remove(name);
+}
+
+TEST_CASE("Data.SharedHashTable.Buckets", "[SharedHashTable]") {
+    const auto name = unique_segment_name("buckets");
+    SharedHashTable::remove(name);
+    SharedHashTable table{name, 1};
+    const auto stride = table.bucket_count();
+
+    for (std::uint64_t index = 0; index < 2 * SharedHashTable::entries_per_bucket; ++index) {
+        table.store(ZobristHash{7 + index * stride}, index + 100);
+        CHECK(table.probe(ZobristHash{7 + index * stride}) == index + 100);
+    }
+    int found{0};
+    for (std::uint64_t index = 0; index < 2 * SharedHashTable::entries_per_bucket; ++index) {
+        found += table.probe(ZobristHash{7 + index * stride}).has_value() ? 1 : 0;
+    }
+    CHECK(found == SharedHashTable::entries_per_bucket);
+    SharedHashTable::remove(name);
+}
+
+TEST_CASE("Data.SharedHashTable.Processes", "[SharedHashTable]") {
+    const auto name = unique_segment_name("processes");
+    SharedHashTable::remove(name);
+    SharedHashTable table{name, 1};
+    auto position = Position::start_position();
+
+    const auto child = fork();
+    REQUIRE(child >= 0);
+    if (child == 0) {
+        SharedHashTable shared{name, 1};
+        shared.store(position.hash(), perft(position, 3));
+        _exit(shared.created() ? 1 : 0);
+    }
+    int status{0};
+    REQUIRE(waitpid(child, &status, 0) == child);
+    CHECK(WIFEXITED(status));
+    CHECK(WEXITSTATUS(status) == 0);
+    CHECK(table.probe(position.hash()) == 8902U);
+    SharedHashTable::remove(name);
+}
+
+#endif
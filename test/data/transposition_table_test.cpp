@@ -0,0 +1,158 @@
+/* ************************************************************************** *
+ * Chess Core                                                                 *
+ * Data structures and algorithms for chess                                   *
+ * ************************************************************************** */
+
+#include <catch2/catch_all.hpp>
+
+#include "chesscore/position.h"
+#include "chesscore/transposition_table.h"
+
+#include <cstdint>
+#include <thread>
+#include <utility>
+#include <vector>
+
+using namespace chesscore;
+
+TEST_CASE("Data.TranspositionTable.Size", "[TranspositionTable]") {
+    TranspositionTable table{1};
+    CHECK(table.bucket_count() == 1024 * 1024 / 64);
+    CHECK(table.entry_count() == table.bucket_count() * TranspositionTable::entries_per_bucket);
+
+    table.resize(3);
+    CHECK(table.bucket_count() == 2 * 1024 * 1024 / 64);
+
+    const TranspositionTable empty{};
+    CHECK(empty.bucket_count() == 0);
+    CHECK_FALSE(empty.probe(ZobristHash{42}).has_value());
+    CHECK(empty.hashfull() == 0);
+}
+
+TEST_CASE("Data.TranspositionTable.Move", "[TranspositionTable]") {
+    TranspositionTable table{1};
+    const ZobristHash hash{0x123456789ABCDEF0ULL};
+    table.store(hash, TranspositionData{.score = 10, .depth = 5, .bound = Bound::Exact});
+
+    TranspositionTable moved{std::move(table)};
+    CHECK(moved.bucket_count() == 1024 * 1024 / 64);
+    CHECK(moved.probe(hash)->score == 10);
+    CHECK(table.bucket_count() == 0);
+    CHECK_FALSE(table.probe(hash).has_value());
+    table.store(hash, TranspositionData{.score = 20, .depth = 5, .bound = Bound::Exact});
+
+    TranspositionTable assigned{2};
+    assigned = std::move(moved);
+    CHECK(assigned.bucket_count() == 1024 * 1024 / 64);
+    CHECK(assigned.probe(hash)->score == 10);
+    CHECK(moved.bucket_count() == 0);
+    CHECK_FALSE(moved.probe(hash).has_value());
+}
+
+TEST_CASE("Data.TranspositionTable.Store and Probe", "[TranspositionTable]") {
+    TranspositionTable table{1};
+    const auto position = Position::start_position();
+    const auto moves = position.all_legal_moves();
+    const TranspositionData data{.move = PackedMove{moves.front()}, .score = -35, .eval = 12, .depth = 7, .bound = Bound::Lower};
+
+    CHECK_FALSE(table.probe(position.hash()).has_value());
+    table.store(position.hash(), data);
+    const auto stored = table.probe(position.hash());
+    REQUIRE(stored.has_value());
+    CHECK(stored.value() == data);
+    CHECK(stored->move.matches(moves.front()));
+    CHECK_FALSE(table.probe(position.key_after(moves.front())).has_value());
+
+    table.clear();
+    CHECK_FALSE(table.probe(position.hash()).has_value());
+}
+
+TEST_CASE("Data.TranspositionTable.Same Position", "[TranspositionTable]") {
+    TranspositionTable table{1};
+    const ZobristHash hash{0x123456789ABCDEF0ULL};
+    const PackedMove move{Move{.from = Square::G1, .to = Square::F3, .piece = Piece::WhiteKnight}};
+
+    table.store(hash, TranspositionData{.move = move, .score = 10, .depth = 10, .bound = Bound::Lower});
+    table.store(hash, TranspositionData{.score = 20, .depth = 2, .bound = Bound::Upper});
+    CHECK(table.probe(hash)->score == 10);
+
+    table.store(hash, TranspositionData{.score = 30, .depth = 8, .bound = Bound::Upper});
+    CHECK(table.probe(hash)->score == 30);
+    CHECK(table.probe(hash)->move == move);
+
+    table.store(hash, TranspositionData{.score = 40, .depth = 1, .bound = Bound::Exact});
+    CHECK(table.probe(hash)->score == 40);
+
+    table.new_search();
+    table.store(hash, TranspositionData{.score = 50, .depth = 0, .bound = Bound::Upper});
+    CHECK(table.probe(hash)->score == 50);
+}
+
+TEST_CASE("Data.TranspositionTable.Replacement", "[TranspositionTable]") {
+    TranspositionTable table{1};
+    const auto bucket_stride = table.bucket_count();
+    const auto key = [&](std::uint64_t index) { return ZobristHash{5 + index * bucket_stride}; };
+
+    for (std::uint64_t index = 0; index < TranspositionTable::entries_per_bucket; ++index) {
+        table.store(key(index), TranspositionData{.depth = static_cast<std::int8_t>(10 + index), .bound = Bound::Exact});
+    }
+    table.store(key(4), TranspositionData{.depth = 1, .bound = Bound::Exact});
+    CHECK_FALSE(table.probe(key(0)).has_value());
+    CHECK(table.probe(key(1)).has_value());
+    CHECK(table.probe(key(4)).has_value());
+
+    // entries of the previous search are replaced before deeper ones of the current search
+    table.new_search();
+    table.store(key(1), TranspositionData{.depth = 11, .bound = Bound::Exact});
+    table.store(key(4), TranspositionData{.depth = 6, .bound = Bound::Exact});
+    table.store(key(5), TranspositionData{.depth = 1, .bound = Bound::Exact});
+    CHECK(table.probe(key(5)).has_value());
+    CHECK_FALSE(table.probe(key(2)).has_value());
+    CHECK(table.probe(key(1)).has_value());
+    CHECK(table.probe(key(3)).has_value());
+    CHECK(table.probe(key(4)).has_value());
+}
+
+TEST_CASE("Data.TranspositionTable.Hashfull", "[TranspositionTable]") {
+    TranspositionTable table{1};
+    CHECK(table.hashfull() == 0);
+    for (std::uint64_t index = 0; index < table.entry_count(); ++index) {
+        table.store(ZobristHash{index}, TranspositionData{.score = 1, .depth = 1, .bound = Bound::Exact});
+    }
+    CHECK(table.hashfull() > 0);
+    table.new_search();
+    CHECK(table.hashfull() == 0);
+}
+
+TEST_CASE("Data.TranspositionTable.Concurrent Access", "[TranspositionTable]") {
+    TranspositionTable table{1};
+    constexpr int thread_count{4};
+    constexpr std::uint64_t key_count{20000};
+    constexpr std::uint64_t key_step{0x9E3779B97F4A7C15U};
+    // every key stores data derived from the key, so any entry read back must be consistent
+    const auto data_for = [](std::uint64_t key) {
+        return TranspositionData{.score = static_cast<std::int16_t>(key & 0x7FFFU), .depth = static_cast<std::int8_t>(key % 64), .bound = Bound::Exact};
+    };
+
+    std::vector<std::thread> threads;
+    std::vector<int> mismatches(thread_count, 0);
+    for (int thread = 0; thread < thread_count; ++thread) {
+        threads.emplace_back([&, thread] {
+            for (std::uint64_t round = 0; round < key_count; ++round) {
+                const std::uint64_t key = (round * key_step) ^ static_cast<std::uint64_t>(thread % 2);
+                table.store(ZobristHash{key}, data_for(key));
+                const auto other = (key * 31) | 1U;
+                const auto stored = table.probe(ZobristHash{other});
+                if (stored.has_value() && !(stored.value() == data_for(other))) {
+                    ++mismatches[static_cast<std::size_t>(thread)];
+                }
+            }
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    for (const auto mismatch : mismatches) {
+        CHECK(mismatch == 0);
+    }
+}
@@ -9,65 +9,36 @@
 #include "chesscore/position.h"
 #include "chesscore/zobrist.h"
 
+#include <algorithm>
+#include <vector>
+
 using namespace chesscore;
 
-TEST_CASE("Data.Zobrist.ZobristKeys.Initialization", "[zobrist]") {
-    ZobristKeys::initialize();
-    CHECK(ZobristKeys::initialized());
+TEST_CASE("Data.Zobrist.ZobristKeys.Compile Time", "[zobrist]") {
+    STATIC_REQUIRE(ZobristKeys::side_key() != 0);
+    STATIC_REQUIRE(zobrist_keys::piece_keys.size() == 2 * piece_type_count * Square::count);
+    STATIC_REQUIRE(ZobristKeys::castling_key(CastlingRights::none()) != ZobristKeys::castling_key(CastlingRights::all()));
 }
 
-TEST_CASE("Data.Zobrist.ZobristKeys.Nonzero", "[zobrist]") {
-    ZobristKeys::initialize();
+TEST_CASE("Data.Zobrist.ZobristKeys.Unique", "[zobrist]") {
+    std::vector<ZobristKeys::key_t> keys{zobrist_keys::piece_keys.begin(), zobrist_keys::piece_keys.end()};
+    keys.insert(keys.end(), zobrist_keys::castling_keys.begin(), zobrist_keys::castling_keys.end());
+    keys.insert(keys.end(), zobrist_keys::enpassant_keys.begin(), zobrist_keys::enpassant_keys.end());
+    keys.push_back(zobrist_keys::side_key);
+    std::ranges::sort(keys);
+    CHECK(std::ranges::adjacent_find(keys) == keys.end());
+}
 
+TEST_CASE("Data.Zobrist.ZobristKeys.Nonzero", "[zobrist]") {
     CHECK(ZobristKeys::side_key() != 0);
 
     for (int file = File::min_file; file <= File::max_file; ++file) {
         CHECK(ZobristKeys::enpassant_key(File{file}) != 0);
     }
 
-    CastlingRights rights{};
-    CHECK(ZobristKeys::castling_key(rights) != 0);
-    rights.black_kingside = true;
-    CHECK(ZobristKeys::castling_key(rights) != 0); // k
-    rights.black_kingside = false;
-    rights.black_queenside = true;
-    CHECK(ZobristKeys::castling_key(rights) != 0); // q
-    rights.black_kingside = true;
-    CHECK(ZobristKeys::castling_key(rights) != 0); // kq
-    rights.black_kingside = false;
-    rights.black_queenside = false;
-    rights.white_kingside = true;
-    CHECK(ZobristKeys::castling_key(rights) != 0); // K
-    rights.black_kingside = true;
-    CHECK(ZobristKeys::castling_key(rights) != 0); // Kk
-    rights.black_kingside = false;
-    rights.black_queenside = true;
-    CHECK(ZobristKeys::castling_key(rights) != 0); // Kq
-    rights.black_kingside = true;
-    CHECK(ZobristKeys::castling_key(rights) != 0); // Kkq
-    rights.black_kingside = false;
-    rights.black_queenside = false;
-    rights.white_kingside = false;
-    rights.white_queenside = true;
-    CHECK(ZobristKeys::castling_key(rights) != 0); // Q
-    rights.black_kingside = true;
-    CHECK(ZobristKeys::castling_key(rights) != 0); // Qk
-    rights.black_kingside = false;
-    rights.black_queenside = true;
-    CHECK(ZobristKeys::castling_key(rights) != 0); // Qq
-    rights.black_kingside = true;
-    CHECK(ZobristKeys::castling_key(rights) != 0); // Qkq
-    rights.black_kingside = false;
-    rights.black_queenside = false;
-    rights.white_kingside = true;
-    CHECK(ZobristKeys::castling_key(rights) != 0); // QK
-    rights.black_kingside = true;
-    CHECK(ZobristKeys::castling_key(rights) != 0); // QKk
-    rights.black_kingside = false;
-    rights.black_queenside = true;
-    CHECK(ZobristKeys::castling_key(rights) != 0); // QKq
-    rights.black_kingside = true;
-    CHECK(ZobristKeys::castling_key(rights) != 0); // QKkq
+    for (std::uint8_t mask = 0; mask < CastlingRights::count; ++mask) {
+        CHECK(ZobristKeys::castling_key(CastlingRights{mask}) != 0);
+    }
 
     auto color = Color::White;
     for (const auto &type : all_piece_types) {
@@ -0,0 +1,92 @@
+/* ************************************************************************** *
+ * Chess Core                                                                 *
+ * Data structures and algorithms for chess                                   *
+ * ************************************************************************** */
+
+#include <algorithm>
+
+#include <catch2/catch_all.hpp>
+
+#include "chesscore/position.h"
+
+using namespace chesscore;
+
+TEST_CASE("Position.CheckInfo.Starting Position", "[position][checkinfo]") {
+    const Position position{FenString::starting_position()};
+    CHECK(position.checkers().empty());
+    CHECK(position.pinned_pieces(Color::White).empty());
+    CHECK(position.pinned_pieces(Color::Black).empty());
+    CHECK(position.king_square(Color::White) == Square::E1);
+    CHECK(position.king_square(Color::Black) == Square::E8);
+}
+
+TEST_CASE("Position.CheckInfo.Checkers", "[position][checkinfo]") {
+    const Position position{FenString{"4k3/8/8/8/8/5n2/8/4K2r w - - 0 1"}};
+    Bitmap expected{};
+    expected.set(Square::F3);
+    expected.set(Square::H1);
+    CHECK(position.checkers() == expected);
+    CHECK(position.is_king_in_check(Color::White));
+    CHECK_FALSE(position.is_king_in_check(Color::Black));
+    const auto moves = position.all_legal_moves();
+    CHECK(std::ranges::all_of(moves, [](const Move &move) { return move.piece == Piece::WhiteKing; }));
+}
+
+TEST_CASE("Position.CheckInfo.Pinned Pieces", "[position][checkinfo]") {
+    const Position position{FenString{"4k3/4r3/8/b7/8/2N5/4B3/4K3 w - - 0 1"}};
+    Bitmap white_pinned{};
+    white_pinned.set(Square::C3);
+    white_pinned.set(Square::E2);
+    CHECK(position.pinned_pieces(Color::White) == white_pinned);
+    CHECK(position.pinned_pieces(Color::Black).empty());
+    const auto moves = position.all_legal_moves();
+    CHECK(std::ranges::none_of(moves, [](const Move &move) { return move.piece == Piece::WhiteBishop || move.piece == Piece::WhiteKnight; }));
+}
+
+TEST_CASE("Position.CheckInfo.Make Unmake", "[position][checkinfo]") {
+    Position position{FenString{"4k3/8/8/8/8/8/3q4/4K3 b - - 0 1"}};
+    const Move check{.from = Square::D2, .to = Square::E2, .piece = Piece::BlackQueen};
+    position.make_move(check);
+    Bitmap expected{};
+    expected.set(Square::E2);
+    CHECK(position.checkers() == expected);
+    position.unmake_move(check);
+    CHECK(position.checkers().empty());
+    CHECK(position.pinned_pieces(Color::White).empty());
+    CHECK(position.king_square(Color::White) == Square::E1);
+    CHECK(position.king_square(Color::Black) == Square::E8);
+}
+
+TEST_CASE("Position.CheckInfo.Gives Check", "[position][checkinfo]") {
+    const auto fen = GENERATE(
+        "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1", "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1",
+        "r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1", "rnbq1k1r/pp1Pbppp/2p5/8/2B5/8/PPP1NnPP/RNBQK2R w KQ - 1 8",
+        "5k2/8/8/8/8/8/8/4K2R w K - 0 1", "3k4/8/8/8/8/8/8/R3K3 w Q - 0 1", "8/8/8/R2pP2k/8/8/8/4K3 w - d6 0 1", "4k3/8/8/8/4N3/8/8/4R1K1 w - - 0 1",
+        "1k6/8/8/8/8/8/3p4/6K1 b - - 0 1", "3r4/4P3/5k2/8/8/8/8/K7 w - - 0 1"
+    );
+    Position position{FenString{fen}};
+    for (const auto &move : position.all_legal_moves()) {
+        const bool expected = [&] {
+            position.make_move(move);
+            const bool in_check = position.is_king_in_check(position.side_to_move());
+            position.unmake_move(move);
+            return in_check;
+        }();
+        CHECK(position.gives_check(move) == expected);
+    }
+}
+
+TEST_CASE("Position.CheckInfo.Gives Check Special Moves", "[position][checkinfo]") {
+    const Position castling{FenString{"5k2/8/8/8/8/8/8/4K2R w K - 0 1"}};
+    CHECK(castling.gives_check(Move{.from = Square::E1, .to = Square::G1, .piece = Piece::WhiteKing}));
+
+    const Position en_passant{FenString{"8/8/8/R2pP2k/8/8/8/4K3 w - d6 0 1"}};
+    CHECK(en_passant.gives_check(Move{.from = Square::E5, .to = Square::D6, .piece = Piece::WhitePawn, .captured = Piece::BlackPawn, .capturing_en_passant = true}));
+
+    const Position promotion{FenString{"1k6/8/8/8/8/8/3p4/6K1 b - - 0 1"}};
+    CHECK_FALSE(promotion.gives_check(Move{.from = Square::D2, .to = Square::D1, .piece = Piece::BlackPawn, .promoted = Piece::BlackKnight}));
+    CHECK(promotion.gives_check(Move{.from = Square::D2, .to = Square::D1, .piece = Piece::BlackPawn, .promoted = Piece::BlackQueen}));
+
+    const Position discovered{FenString{"4k3/8/8/8/4N3/8/8/4R1K1 w - - 0 1"}};
+    CHECK(discovered.gives_check(Move{.from = Square::E4, .to = Square::C5, .piece = Piece::WhiteKnight}));
+}
@@ -7,6 +7,7 @@
 
 #include "chesscore/position.h"
 
+#include <array>
 #include <ranges>
 
 using namespace chesscore;
@@ -283,3 +284,171 @@ TEST_CASE("Position.Hashing.UnmakeMove.Promotion", "[position][zobrist]") {
     position_b.unmake_move(move_b);
     CHECK(position_b.hash() == hash_b);
 }
+
+namespace {
+
+auto same_piece_hashes(const Position &position) -> bool {
+    HashHistory history{};
+    auto reference = Position{FenString{position.piece_placement(), position.state()}};
+    reference.attach_history(history);
+    bool same = position.pawn_hash() == reference.pawn_hash() && position.material_hash() == reference.material_hash() &&
+                position.non_pawn_hash(Color::White) == reference.non_pawn_hash(Color::White) && position.non_pawn_hash(Color::Black) == reference.non_pawn_hash(Color::Black);
+    for (size_t index = min_white_piece_index; index <= max_black_piece_index; ++index) {
+        const auto piece = Piece{.type = piece_type_from_index(index % piece_type_count), .color = index <= max_white_piece_index ? Color::White : Color::Black};
+        same = same && position.piece_count(piece) == position.board().piece_count(piece);
+    }
+    return same;
+}
+
+auto check_piece_hashes(Position &position, int depth) -> bool {
+    if (!same_piece_hashes(position)) {
+        return false;
+    }
+    if (depth == 0) {
+        return true;
+    }
+    for (const auto &move : position.all_legal_moves()) {
+        position.make_move(move);
+        const bool same = check_piece_hashes(position, depth - 1);
+        position.unmake_move(move);
+        if (!same) {
+            return false;
+        }
+    }
+    return same_piece_hashes(position);
+}
+
+} // namespace
+
+TEST_CASE("Position.Hashing.PieceHashes.Initialization", "[position][zobrist]") {
+    HashHistory history{};
+    auto empty_position = Position{};
+    empty_position.attach_history(history);
+    CHECK(empty_position.pawn_hash() == ZobristHash{});
+    CHECK(empty_position.material_hash() == ZobristHash{});
+    CHECK(empty_position.piece_count(Piece::WhitePawn) == 0);
+
+    HashHistory starting_history{};
+    auto starting_position = Position::start_position();
+    starting_position.attach_history(starting_history);
+    CHECK(starting_position.piece_count(Piece::WhitePawn) == 8);
+    CHECK(starting_position.piece_count(Piece::BlackKnight) == 2);
+    CHECK(starting_position.piece_count(Piece::BlackKing) == 1);
+
+    HashHistory mirrored_history{};
+    auto mirrored = Position{FenString{"rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR b KQkq - 0 1"}};
+    mirrored.attach_history(mirrored_history);
+    CHECK(mirrored.pawn_hash() == starting_position.pawn_hash());
+    CHECK(mirrored.material_hash() == starting_position.material_hash());
+}
+
+TEST_CASE("Position.Hashing.PieceHashes.Without History", "[position][zobrist]") {
+    HashHistory history{};
+    auto attached = Position{FenString{"r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1"}};
+    attached.attach_history(history);
+    const auto detached = Position{FenString{"r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1"}};
+    CHECK(detached.history() == nullptr);
+    CHECK(detached.pawn_hash() == attached.pawn_hash());
+    CHECK(detached.non_pawn_hash(Color::White) == attached.non_pawn_hash(Color::White));
+    CHECK(detached.non_pawn_hash(Color::Black) == attached.non_pawn_hash(Color::Black));
+    CHECK(detached.material_hash() == attached.material_hash());
+
+    auto moved = Position::start_position();
+    moved.make_move(Move{.from = Square::E2, .to = Square::E4, .piece = Piece::WhitePawn});
+    CHECK_FALSE(moved.pawn_hash() == Position::start_position().pawn_hash());
+    CHECK(moved.material_hash() == Position::start_position().material_hash());
+}
+
+TEST_CASE("Position.Hashing.PieceHashes.Material", "[position][zobrist]") {
+    std::array<HashHistory, 3> histories{};
+    auto position1 = Position{FenString{"4k3/8/8/3n4/8/8/2B5/4K3 w - - 0 1"}};
+    auto position2 = Position{FenString{"4k3/1n6/8/8/6B1/8/8/3K4 b - - 5 20"}};
+    auto position3 = Position{FenString{"4k3/1b6/8/8/6B1/8/8/3K4 b - - 5 20"}};
+    position1.attach_history(histories[0]);
+    position2.attach_history(histories[1]);
+    position3.attach_history(histories[2]);
+    CHECK(position1.material_hash() == position2.material_hash());
+    CHECK_FALSE(position1.material_hash() == position3.material_hash());
+    CHECK_FALSE(position1.pawn_hash() == ZobristHash{1});
+}
+
+TEST_CASE("Position.Hashing.PieceHashes.MakeMove", "[position][zobrist]") {
+    HashHistory history{};
+    auto position = Position::start_position();
+    position.attach_history(history);
+    const auto pawn_hash = position.pawn_hash();
+    const auto material_hash = position.material_hash();
+
+    position.make_move(Move{.from = Square::G1, .to = Square::F3, .piece = Piece::WhiteKnight});
+    CHECK(position.pawn_hash() == pawn_hash);
+    CHECK(position.material_hash() == material_hash);
+    CHECK(same_piece_hashes(position));
+
+    position.make_move(Move{.from = Square::E7, .to = Square::E5, .piece = Piece::BlackPawn});
+    CHECK_FALSE(position.pawn_hash() == pawn_hash);
+    CHECK(position.material_hash() == material_hash);
+    CHECK(same_piece_hashes(position));
+
+    position.make_move(Move{.from = Square::F3, .to = Square::E5, .piece = Piece::WhiteKnight, .captured = Piece::BlackPawn});
+    CHECK_FALSE(position.material_hash() == material_hash);
+    CHECK(position.piece_count(Piece::BlackPawn) == 7);
+    CHECK(same_piece_hashes(position));
+}
+
+TEST_CASE("Position.Hashing.PieceHashes.MakeUnmake", "[position][zobrist]") {
+    HashHistory history{};
+    auto kiwipete = Position{FenString{"r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1"}};
+    kiwipete.attach_history(history);
+    CHECK(check_piece_hashes(kiwipete, 2));
+    auto promotions = Position{FenString{"n1n5/PPPk4/8/8/8/8/4Kppp/5N1N b - - 0 1"}};
+    promotions.attach_history(history);
+    CHECK(check_piece_hashes(promotions, 2));
+    auto en_passant = Position{FenString{"8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1"}};
+    en_passant.attach_history(history);
+    CHECK(check_piece_hashes(en_passant, 3));
+}
+
+namespace {
+
+auto check_key_after(Position &position, int depth) -> bool {
+    if (depth == 0) {
+        return true;
+    }
+    for (const auto &move : position.all_legal_moves()) {
+        const auto key = position.key_after(move);
+        position.make_move(move);
+        const bool same = key == position.hash() && check_key_after(position, depth - 1);
+        position.unmake_move(move);
+        if (!same) {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+TEST_CASE("Position.Hashing.KeyAfter", "[position][zobrist]") {
+    auto start = Position::start_position();
+    CHECK(check_key_after(start, 3));
+    auto kiwipete = Position{FenString{"r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1"}};
+    CHECK(check_key_after(kiwipete, 2));
+    auto promotions = Position{FenString{"n1n5/PPPk4/8/8/8/8/4Kppp/5N1N b - - 0 1"}};
+    CHECK(check_key_after(promotions, 2));
+    auto en_passant = Position{FenString{"8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1"}};
+    CHECK(check_key_after(en_passant, 3));
+}
+
+TEST_CASE("Position.Hashing.Consecutive Double Steps", "[position][zobrist]") {
+    auto position = Position::start_position();
+    const auto e4 = find_move(position.all_legal_moves(), Move{.from = Square::E2, .to = Square::E4, .piece = Piece::WhitePawn});
+    position.make_move(e4);
+    const auto hash_after_e4 = position.hash();
+    const auto d5 = find_move(position.all_legal_moves(), Move{.from = Square::D7, .to = Square::D5, .piece = Piece::BlackPawn});
+    position.make_move(d5);
+    CHECK(position.hash() == ZobristHash::from_position(position));
+    position.unmake_move(d5);
+    CHECK(position.hash() == hash_after_e4);
+    position.unmake_move(e4);
+    CHECK(position.hash() == ZobristHash::starting_position_hash());
+}
@@ -0,0 +1,98 @@
+/* ************************************************************************** *
+ * Chess Core                                                                 *
+ * Data structures and algorithms for chess                                   *
+ * ************************************************************************** */
+
+#include <catch2/catch_all.hpp>
+
+#include "chesscore/position.h"
+
+using namespace chesscore;
+
+namespace {
+
+// all moves of the pieces of the player to move to any square, including illegal ones
+auto candidate_moves(const Position &position) -> MoveList {
+    MoveList candidates{};
+    const auto &board = position.board();
+    for (const auto from : board.bitmap(position.side_to_move())) {
+        const auto piece = board.get_piece(from).value();
+        for (std::size_t index = 0; index < Square::count; ++index) {
+            const auto to = Square::from_index(index);
+            Move move{.from = from, .to = to, .piece = piece, .captured = board.get_piece(to)};
+            if (piece.type == PieceType::Pawn && (to.rank().rank == Rank::min_rank || to.rank().rank == Rank::max_rank)) {
+                for (const auto type : all_promotion_piece_types) {
+                    move.promoted = Piece{.type = type, .color = piece.color};
+                    candidates.push_back(move);
+                }
+            } else if (piece.type == PieceType::Pawn && position.en_passant_target() == to) {
+                move.captured = Piece{.type = PieceType::Pawn, .color = other_color(piece.color)};
+                move.capturing_en_passant = true;
+                candidates.push_back(move);
+            } else {
+                candidates.push_back(move);
+            }
+        }
+    }
+    return candidates;
+}
+
+} // namespace
+
+TEST_CASE("Position.Legality.Matches Move Generation", "[position][legality]") {
+    const auto fen = GENERATE(
+        "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1", "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+        "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1", "r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1",
+        "rnbq1k1r/pp1Pbppp/2p5/8/2B5/8/PPP1NnPP/RNBQK2R w KQ - 1 8", "4k3/8/8/8/8/5n2/8/4K2r w - - 0 1", "8/8/8/2k5/3pP3/8/8/4K3 b - e3 0 1",
+        "4k3/4r3/8/b7/8/2N5/4B3/4K3 w - - 0 1", "k7/8/8/8/8/4N3/5PPP/3r2K1 w - - 0 1"
+    );
+    const Position position{FenString{fen}};
+    const auto legal_moves = position.all_legal_moves();
+    for (const auto &move : legal_moves) {
+        CHECK(position.is_legal(move));
+    }
+    for (const auto &move : candidate_moves(position)) {
+        CHECK(position.is_legal(move) == move_list_contains(legal_moves, move));
+    }
+}
+
+TEST_CASE("Position.Legality.Mismatching Moves", "[position][legality]") {
+    const Position position{FenString{"r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1"}};
+    CHECK(position.is_legal(Move{.from = Square::E5, .to = Square::F7, .piece = Piece::WhiteKnight, .captured = Piece::BlackPawn}));
+    // wrong piece on the start square
+    CHECK_FALSE(position.is_pseudo_legal(Move{.from = Square::E5, .to = Square::F7, .piece = Piece::WhiteBishop, .captured = Piece::BlackPawn}));
+    // captured piece does not match the board
+    CHECK_FALSE(position.is_pseudo_legal(Move{.from = Square::E5, .to = Square::F7, .piece = Piece::WhiteKnight}));
+    // moving a piece of the opponent
+    CHECK_FALSE(position.is_pseudo_legal(Move{.from = Square::B4, .to = Square::B3, .piece = Piece::BlackPawn}));
+    // blocked slider
+    CHECK_FALSE(position.is_pseudo_legal(Move{.from = Square::A1, .to = Square::A3, .piece = Piece::WhiteRook}));
+    CHECK(position.is_legal(Move{.from = Square::E1, .to = Square::G1, .piece = Piece::WhiteKing}));
+    CHECK(position.is_legal(Move{.from = Square::E1, .to = Square::C1, .piece = Piece::WhiteKing}));
+    // promotion without reaching the last rank
+    CHECK_FALSE(position.is_pseudo_legal(Move{.from = Square::A2, .to = Square::A3, .piece = Piece::WhitePawn, .promoted = Piece::WhiteQueen}));
+
+    const Position pinned{FenString{"4k3/4r3/8/b7/8/2N5/4B3/4K3 w - - 0 1"}};
+    const Move pinned_knight{.from = Square::C3, .to = Square::D5, .piece = Piece::WhiteKnight};
+    CHECK(pinned.is_pseudo_legal(pinned_knight));
+    CHECK_FALSE(pinned.is_legal(pinned_knight));
+    CHECK_FALSE(pinned.is_legal(Move{.from = Square::E2, .to = Square::D3, .piece = Piece::WhiteBishop}));
+    CHECK(pinned.is_legal(Move{.from = Square::E1, .to = Square::D1, .piece = Piece::WhiteKing}));
+    // castling without the right
+    CHECK_FALSE(pinned.is_pseudo_legal(Move{.from = Square::E1, .to = Square::G1, .piece = Piece::WhiteKing}));
+}
+
+TEST_CASE("Position.Legality.Malformed Castling", "[position][legality]") {
+    const Position position{FenString{"r3k2r/8/8/8/8/8/8/R3K2R w KQkq - 0 1"}};
+    CHECK(position.is_legal(Move{.from = Square::E1, .to = Square::G1, .piece = Piece::WhiteKing}));
+    CHECK_FALSE(position.is_legal(Move{.from = Square::E1, .to = Square::G1, .piece = Piece::WhiteKing, .captured = Piece::BlackQueen}));
+    CHECK_FALSE(position.is_legal(Move{.from = Square::E1, .to = Square::G1, .piece = Piece::WhiteKing, .promoted = Piece::WhiteQueen}));
+    CHECK_FALSE(position.is_legal(Move{.from = Square::E1, .to = Square::C1, .piece = Piece::WhiteKing, .capturing_en_passant = true}));
+    CHECK_FALSE(position.is_legal(Move{.from = Square::E1, .to = Square::G1, .piece = Piece::WhiteKing, .captured = Piece::BlackQueen, .promoted = Piece::WhiteQueen}));
+
+    const Position black{FenString{"r3k2r/8/8/8/8/8/8/R3K2R b KQkq - 0 1"}};
+    CHECK(black.is_legal(Move{.from = Square::E8, .to = Square::C8, .piece = Piece::BlackKing}));
+    CHECK_FALSE(black.is_pseudo_legal(Move{.from = Square::E8, .to = Square::C8, .piece = Piece::BlackKing, .captured = Piece::WhiteRook}));
+    CHECK_FALSE(black.is_pseudo_legal(Move{.from = Square::E8, .to = Square::G8, .piece = Piece::BlackKing, .promoted = Piece::BlackRook}));
+    CHECK_FALSE(black.is_pseudo_legal(Move{.from = Square::E8, .to = Square::G8, .piece = Piece::BlackKing, .capturing_en_passant = true}));
+}
@@ -206,3 +206,38 @@ TEST_CASE("Position.MakeMove.Castling Rights", "[Position][MakeMove]") {
     CHECK_FALSE(position.castling_rights()['k']);
     CHECK_FALSE(position.castling_rights()['q']);
 }
+
+TEST_CASE("Position.MakeMove.Null Move", "[Position][MakeMove]") {
+    HashHistory history{};
+    Position position{FenString{"rnbqkbnr/pppp1ppp/8/8/3pP3/8/PPP2PPP/RNBQKBNR b KQkq e3 0 3"}};
+    position.attach_history(history);
+    const auto hash = position.hash();
+
+    const auto null_move = position.make_null_move();
+    CHECK(position.side_to_move() == Color::White);
+    CHECK_FALSE(position.en_passant_target().has_value());
+    CHECK(position.halfmove_clock() == 1);
+    CHECK(position.fullmove_number() == 4);
+    CHECK(position.castling_rights() == CastlingRights::all());
+    CHECK(position.hash() == ZobristHash::from_position(position));
+    CHECK(history.entry(5).hash == hash);
+    CHECK(history.entry(6).hash == position.hash());
+    CHECK(history.entry(6).previous == 0);
+    CHECK(history.entry(6).pawn_hash == history.entry(5).pawn_hash);
+
+    position.unmake_null_move(null_move);
+    CHECK(position.side_to_move() == Color::Black);
+    CHECK(position.en_passant_target() == Square::E3);
+    CHECK(position.halfmove_clock() == 0);
+    CHECK(position.fullmove_number() == 3);
+    CHECK(position.hash() == hash);
+    CHECK(history.entry(5).hash == hash);
+}
+
+TEST_CASE("Position.MakeMove.Null Move Check Info", "[Position][MakeMove]") {
+    Position position{FenString{"4k3/8/8/8/1b6/8/3N4/4K3 b - - 0 1"}};
+    position.make_null_move();
+    const Position reference{FenString{"4k3/8/8/8/1b6/8/3N4/4K3 w - - 1 2"}};
+    CHECK(position.all_legal_moves().size() == reference.all_legal_moves().size());
+    CHECK(position.board().pinned_pieces(Square::E1, Color::White) == Bitmap{Square::D2});
+}
@@ -3,6 +3,9 @@
  * Data structures and algorithms for chess                                   *
  * ************************************************************************** */
 
+#include <algorithm>
+#include <iterator>
+
 #include <catch2/catch_all.hpp>
 
 #include "chesscore/bitboard.h"
@@ -116,3 +119,29 @@ TEST_CASE("Position.Bitboard.MoveGeneration (2)", "[Position][MoveGeneration]")
     CHECK_FALSE(move_list_contains(moves, Move{Square::C6, Square::A4, Piece::BlackBishop}));
     CHECK_FALSE(move_list_contains(moves, Move{Square::C6, Square::D5, Piece::BlackBishop, Piece::WhiteKnight}));
 }
+
+TEST_CASE("Position.Bitboard.MoveGeneration.Pseudo Legal", "[Position][MoveGeneration]") {
+    const auto fen = GENERATE(
+        "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1", "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1",
+        "r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1", "4k3/4r3/8/b7/8/2N5/4B3/4K3 w - - 0 1", "4k3/8/8/8/8/5n2/8/4K2r w - - 0 1"
+    );
+    const Position position{FenString{fen}};
+    const auto legal_moves = position.all_legal_moves();
+    const auto pseudo_legal_moves = position.pseudo_legal_moves();
+    CHECK(pseudo_legal_moves.size() >= legal_moves.size());
+    MoveList filtered{};
+    std::ranges::copy_if(pseudo_legal_moves, std::back_inserter(filtered), [&position](const Move &move) { return position.is_legal_after_pseudo(move); });
+    CHECK(filtered == legal_moves);
+}
+
+TEST_CASE("Position.Bitboard.MoveGeneration.Pseudo Legal Pinned", "[Position][MoveGeneration]") {
+    const Position position{FenString{"4k3/4r3/8/b7/8/2N5/4B3/4K3 w - - 0 1"}};
+    const Move pinned_move{.from = Square::C3, .to = Square::D5, .piece = Piece::WhiteKnight};
+    CHECK(move_list_contains(position.pseudo_legal_moves(), pinned_move));
+    CHECK_FALSE(move_list_contains(position.all_legal_moves(), pinned_move));
+    CHECK_FALSE(position.is_legal_after_pseudo(pinned_move));
+
+    int count{0};
+    position.generate([&count](const Move &) { ++count; }, GenerationMode::PseudoLegal);
+    CHECK(count == static_cast<int>(position.pseudo_legal_moves().size()));
+}
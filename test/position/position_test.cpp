@@ -3,6 +3,9 @@
  * Data structures and algorithms for chess                                   *
  * ************************************************************************** */
 
+#include <cstring>
+#include <type_traits>
+
 #include <catch2/catch_all.hpp>
 
 #include "chesscore/bitboard.h"
@@ -121,3 +124,25 @@ TEST_CASE("Position.Bitboard.Check State.Stalemate", "[Position]") {
     CHECK(Position{FenString{"8/8/8/8/8/5k1q/8/6K1 w - - 0 1"}}.check_state() == CheckState::Stalemate);
     CHECK(Position{FenString{"7k/8/6Q1/8/2K5/8/8/8 b - - 0 1"}}.check_state() == CheckState::Stalemate);
 }
+
+TEST_CASE("Position.Bitboard.Has Legal Move", "[Position]") {
+    const auto fen = GENERATE(
+        "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1", "4k3/4Q3/4K3/8/8/8/8/8 b - - 0 1", "k7/8/1KN5/8/8/8/8/8 b - - 0 1",
+        "8/pkp5/1p4q1/3b4/8/3n4/2r5/5K2 w - - 0 1", "k7/8/8/8/8/4N3/5PPP/3r2K1 w - - 0 1", "k7/8/8/8/8/8/5PPP/3r2K1 w - - 0 1",
+        "4k3/8/8/8/8/5n2/8/4K2r w - - 0 1", "8/8/8/8/8/k7/p7/K7 w - - 0 1", "8/8/8/8/8/k7/p7/K1P5 w - - 0 1",
+        "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1"
+    );
+    const Position position{FenString{fen}};
+    CHECK(position.has_legal_move() == !position.all_legal_moves().empty());
+}
+
+TEST_CASE("Position.Bitboard.Copy", "[Position]") {
+    STATIC_REQUIRE(std::is_trivially_copyable_v<Position>);
+    STATIC_REQUIRE(sizeof(Bitboard) == 64);
+    Position position{FenString{"r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1"}};
+    Position copy{};
+    std::memcpy(static_cast<void *>(&copy), &position, sizeof(Position));
+    CHECK(copy == position);
+    CHECK(copy.hash() == position.hash());
+    CHECK(copy.all_legal_moves().size() == position.all_legal_moves().size());
+}
@@ -0,0 +1,221 @@
+/* ************************************************************************** *
+ * Chess Core                                                                 *
+ * Data structures and algorithms for chess                                   *
+ * ************************************************************************** */
+
+#include <catch2/catch_all.hpp>
+
+#include "chesscore/hash_history.h"
+#include "chesscore/position.h"
+
+using namespace chesscore;
+
+namespace {
+
+auto shuffle_knights(Position &position) -> void {
+    position.make_move(Move{.from = Square::G1, .to = Square::F3, .piece = Piece::WhiteKnight, .halfmove_clock_before = position.halfmove_clock()});
+    position.make_move(Move{.from = Square::G8, .to = Square::F6, .piece = Piece::BlackKnight, .halfmove_clock_before = position.halfmove_clock()});
+    position.make_move(Move{.from = Square::F3, .to = Square::G1, .piece = Piece::WhiteKnight, .halfmove_clock_before = position.halfmove_clock()});
+    position.make_move(Move{.from = Square::F6, .to = Square::G8, .piece = Piece::BlackKnight, .halfmove_clock_before = position.halfmove_clock()});
+}
+
+} // namespace
+
+TEST_CASE("Position.History.HashHistory.Record", "[position][history]") {
+    HashHistory history{};
+    history.start(4).hash = ZobristHash{1};
+    history.record(5).hash = ZobristHash{2};
+    history.record(6).hash = ZobristHash{1};
+    CHECK(history.entry(4).previous == 0);
+    CHECK(history.entry(6).hash == ZobristHash{1});
+    CHECK(history.entry(6).previous == 2);
+    CHECK(history.count(6, 10, 5) == 1);
+    CHECK(history.count(6, 1, 5) == 0);
+    CHECK(history.count(5, 10, 5) == 0);
+
+    history.record(5).hash = ZobristHash{3};
+    CHECK(history.entry(4).hash == ZobristHash{1});
+    CHECK(history.entry(5).hash == ZobristHash{3});
+}
+
+TEST_CASE("Position.History.HashHistory.Wrap Around", "[position][history]") {
+    HashHistory history{};
+    history.start(0).hash = ZobristHash{0};
+    for (std::size_t ply = 1; ply <= HashHistory::capacity + 10; ++ply) {
+        history.record(ply).hash = ZobristHash{ply % 2};
+    }
+    const auto last = HashHistory::capacity + 10;
+    CHECK(history.entry(last).hash == ZobristHash{0});
+    CHECK(history.entry(last).previous == HashHistory::capacity - 1);
+    CHECK(history.entry(last - 1).hash == ZobristHash{1});
+    CHECK(history.count(last, HashHistory::capacity * 2, 1000) == static_cast<int>(HashHistory::capacity / 2 - 1));
+}
+
+TEST_CASE("Position.History.Attach", "[position][history]") {
+    HashHistory history{};
+    auto position = Position::start_position();
+    CHECK(position.history() == nullptr);
+    shuffle_knights(position);
+    CHECK(position.is_repetition(1));
+    CHECK_FALSE(position.is_repetition(2));
+
+    position.attach_history(history);
+    CHECK(position.history() == &history);
+    shuffle_knights(position);
+    CHECK(position.is_repetition(2));
+
+    HashHistory other{};
+    auto copy = position;
+    CHECK(copy.history() == &history);
+    copy.attach_history(other);
+    CHECK(copy.history() == &other);
+    shuffle_knights(copy);
+    CHECK(copy.is_repetition(3));
+}
+
+TEST_CASE("Position.History.Repetition.Threefold", "[position][history]") {
+    HashHistory history{};
+    auto position = Position::start_position();
+    position.attach_history(history);
+    CHECK_FALSE(position.is_repetition(2));
+
+    shuffle_knights(position);
+    CHECK(position.is_repetition(2));
+    CHECK_FALSE(position.is_repetition(3));
+
+    shuffle_knights(position);
+    CHECK(position.is_repetition(2));
+    CHECK(position.is_repetition(3));
+    CHECK_FALSE(position.is_repetition(4));
+}
+
+TEST_CASE("Position.History.Repetition.Unmake", "[position][history]") {
+    HashHistory history{};
+    auto position = Position::start_position();
+    position.attach_history(history);
+    shuffle_knights(position);
+    CHECK(position.is_repetition(2));
+
+    const auto move = Move{.from = Square::F6, .to = Square::G8, .piece = Piece::BlackKnight, .halfmove_clock_before = 3};
+    position.unmake_move(move);
+    CHECK_FALSE(position.is_repetition(2));
+    position.make_move(Move{.from = Square::F6, .to = Square::E4, .piece = Piece::BlackKnight, .halfmove_clock_before = 3});
+    CHECK_FALSE(position.is_repetition(2));
+}
+
+TEST_CASE("Position.History.Repetition.Copy Make", "[position][history]") {
+    HashHistory history{};
+    auto position = Position::start_position();
+    position.attach_history(history);
+    shuffle_knights(position);
+
+    auto child = position;
+    child.make_move(Move{.from = Square::G1, .to = Square::F3, .piece = Piece::WhiteKnight, .halfmove_clock_before = 4});
+    CHECK(child.is_repetition(2));
+    CHECK(position.is_repetition(2));
+    CHECK_FALSE(position.is_repetition(3));
+}
+
+TEST_CASE("Position.History.Sibling Copies", "[position][history]") {
+    HashHistory history{};
+    auto position = Position::start_position();
+    position.attach_history(history);
+
+    HashHistory history_a{};
+    HashHistory history_b{};
+    auto sibling_a = position;
+    auto sibling_b = position;
+    sibling_a.attach_history(history_a);
+    sibling_b.attach_history(history_b);
+    sibling_a.make_move(Move{.from = Square::E2, .to = Square::E4, .piece = Piece::WhitePawn});
+    sibling_b.make_move(Move{.from = Square::G1, .to = Square::F3, .piece = Piece::WhiteKnight});
+
+    HashHistory reference_history{};
+    auto reference = Position{FenString{"rnbqkbnr/pppppppp/8/8/4P3/8/PPPP1PPP/RNBQKBNR b KQkq e3 0 1"}};
+    reference.attach_history(reference_history);
+    CHECK(sibling_a.pawn_hash() == reference.pawn_hash());
+    CHECK_FALSE(sibling_a.pawn_hash() == sibling_b.pawn_hash());
+    CHECK(sibling_b.pawn_hash() == position.pawn_hash());
+}
+
+TEST_CASE("Position.History.Shared Sibling Copies", "[position][history]") {
+    HashHistory history{};
+    auto position = Position::start_position();
+    position.attach_history(history);
+
+    auto sibling_a = position;
+    auto sibling_b = position;
+    sibling_a.make_move(Move{.from = Square::E2, .to = Square::E4, .piece = Piece::WhitePawn});
+    sibling_b.make_move(Move{.from = Square::G1, .to = Square::F3, .piece = Piece::WhiteKnight});
+
+    const auto reference = Position{FenString{"rnbqkbnr/pppppppp/8/8/4P3/8/PPPP1PPP/RNBQKBNR b KQkq e3 0 1"}};
+    CHECK(sibling_a.pawn_hash() == reference.pawn_hash());
+    CHECK(sibling_a.non_pawn_hash(Color::White) == reference.non_pawn_hash(Color::White));
+    CHECK_FALSE(sibling_a.is_repetition(2));
+
+    // the overwritten copy starts a new line in the history
+    sibling_a.make_move(Move{.from = Square::G8, .to = Square::F6, .piece = Piece::BlackKnight, .en_passant_target_before = Square::E3});
+    CHECK(sibling_a.history() == &history);
+    CHECK_FALSE(sibling_a.is_repetition(2));
+    sibling_a.make_move(Move{.from = Square::G1, .to = Square::F3, .piece = Piece::WhiteKnight, .halfmove_clock_before = 1});
+    sibling_a.make_move(Move{.from = Square::F6, .to = Square::G8, .piece = Piece::BlackKnight, .halfmove_clock_before = 2});
+    sibling_a.make_move(Move{.from = Square::F3, .to = Square::G1, .piece = Piece::WhiteKnight, .halfmove_clock_before = 3});
+    sibling_a.make_move(Move{.from = Square::G8, .to = Square::F6, .piece = Piece::BlackKnight, .halfmove_clock_before = 4});
+    CHECK(sibling_a.is_repetition(2));
+    const auto reference_after = Position{FenString{"rnbqkb1r/pppppppp/5n2/8/4P3/8/PPPP1PPP/RNBQKBNR w KQkq - 5 3"}};
+    CHECK(sibling_a.pawn_hash() == reference_after.pawn_hash());
+    CHECK(sibling_a.non_pawn_hash(Color::Black) == reference_after.non_pawn_hash(Color::Black));
+    CHECK(sibling_a.material_hash() == reference_after.material_hash());
+}
+
+TEST_CASE("Position.History.Repetition.Null Move", "[position][history]") {
+    HashHistory history{};
+    auto position = Position{FenString{"4k3/8/8/8/8/8/8/4K3 w - - 0 1"}};
+    position.attach_history(history);
+    const auto initial_hash = position.hash();
+
+    position.make_null_move();
+    // black triangulates, so that white is to move in the initial position again
+    position.make_move(Move{.from = Square::E8, .to = Square::D8, .piece = Piece::BlackKing, .halfmove_clock_before = position.halfmove_clock()});
+    position.make_move(Move{.from = Square::E1, .to = Square::D1, .piece = Piece::WhiteKing, .halfmove_clock_before = position.halfmove_clock()});
+    position.make_move(Move{.from = Square::D8, .to = Square::D7, .piece = Piece::BlackKing, .halfmove_clock_before = position.halfmove_clock()});
+    position.make_move(Move{.from = Square::D1, .to = Square::E1, .piece = Piece::WhiteKing, .halfmove_clock_before = position.halfmove_clock()});
+    position.make_move(Move{.from = Square::D7, .to = Square::E8, .piece = Piece::BlackKing, .halfmove_clock_before = position.halfmove_clock()});
+    CHECK(position.hash() == initial_hash);
+    CHECK(position.halfmove_clock() == 6);
+    CHECK_FALSE(position.is_repetition(2));
+
+    // repetitions after the null move are still detected
+    position.make_move(Move{.from = Square::E1, .to = Square::D1, .piece = Piece::WhiteKing, .halfmove_clock_before = position.halfmove_clock()});
+    position.make_move(Move{.from = Square::E8, .to = Square::D8, .piece = Piece::BlackKing, .halfmove_clock_before = position.halfmove_clock()});
+    position.make_move(Move{.from = Square::D1, .to = Square::E1, .piece = Piece::WhiteKing, .halfmove_clock_before = position.halfmove_clock()});
+    position.make_move(Move{.from = Square::D8, .to = Square::E8, .piece = Piece::BlackKing, .halfmove_clock_before = position.halfmove_clock()});
+    CHECK(position.is_repetition(2));
+}
+
+TEST_CASE("Position.History.Repetition.Irreversible Move", "[position][history]") {
+    HashHistory history{};
+    auto position = Position::start_position();
+    position.attach_history(history);
+    position.make_move(Move{.from = Square::G1, .to = Square::F3, .piece = Piece::WhiteKnight});
+    position.make_move(Move{.from = Square::G8, .to = Square::F6, .piece = Piece::BlackKnight, .halfmove_clock_before = 1});
+    position.make_move(Move{.from = Square::E2, .to = Square::E4, .piece = Piece::WhitePawn, .halfmove_clock_before = 2});
+    position.make_move(Move{.from = Square::F6, .to = Square::G8, .piece = Piece::BlackKnight, .en_passant_target_before = Square::E3});
+    position.make_move(Move{.from = Square::F3, .to = Square::G1, .piece = Piece::WhiteKnight, .halfmove_clock_before = 1});
+    position.make_move(Move{.from = Square::G8, .to = Square::F6, .piece = Piece::BlackKnight, .halfmove_clock_before = 2});
+    position.make_move(Move{.from = Square::G1, .to = Square::F3, .piece = Piece::WhiteKnight, .halfmove_clock_before = 3});
+    CHECK(position.halfmove_clock() == 4);
+    CHECK_FALSE(position.is_repetition(2));
+    position.make_move(Move{.from = Square::F6, .to = Square::G8, .piece = Piece::BlackKnight, .halfmove_clock_before = 4});
+    CHECK(position.is_repetition(2));
+}
+
+TEST_CASE("Position.History.Fifty Move Rule", "[position][history]") {
+    CHECK_FALSE(Position{FenString{"4k3/8/8/8/8/8/8/R3K3 w - - 99 80"}}.is_fifty_move_draw());
+    CHECK(Position{FenString{"4k3/8/8/8/8/8/8/R3K3 w - - 100 80"}}.is_fifty_move_draw());
+    CHECK(Position{FenString{"4k3/8/8/8/8/8/8/R3K3 w - - 300 80"}}.halfmove_clock() == 255);
+
+    auto position = Position{FenString{"4k3/8/8/8/8/8/8/R3K3 w - - 99 80"}};
+    position.make_move(Move{.from = Square::A1, .to = Square::A2, .piece = Piece::WhiteRook, .halfmove_clock_before = 99});
+    CHECK(position.is_fifty_move_draw());
+}
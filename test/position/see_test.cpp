@@ -0,0 +1,72 @@
+/* ************************************************************************** *
+ * Chess Core                                                                 *
+ * Data structures and algorithms for chess                                   *
+ * ************************************************************************** */
+
+#include <catch2/catch_all.hpp>
+
+#include "chesscore/position.h"
+
+using namespace chesscore;
+
+TEST_CASE("Position.SEE.Simple Captures", "[position][see]") {
+    const Position undefended{FenString{"4k3/8/8/3p4/4P3/8/8/4K3 w - - 0 1"}};
+    const Move pawn_takes_pawn{.from = Square::E4, .to = Square::D5, .piece = Piece::WhitePawn, .captured = Piece::BlackPawn};
+    CHECK(undefended.see(pawn_takes_pawn) == 100);
+
+    const Position defended_knight{FenString{"4k3/8/2p5/3n4/4P3/8/8/4K3 w - - 0 1"}};
+    const Move pawn_takes_knight{.from = Square::E4, .to = Square::D5, .piece = Piece::WhitePawn, .captured = Piece::BlackKnight};
+    CHECK(defended_knight.see(pawn_takes_knight) == 200);
+    CHECK(defended_knight.see_ge(pawn_takes_knight, 200));
+    CHECK_FALSE(defended_knight.see_ge(pawn_takes_knight, 201));
+
+    const Position defended_pawn{FenString{"4k3/8/2p5/3p4/8/8/8/3RK3 w - - 0 1"}};
+    const Move rook_takes_pawn{.from = Square::D1, .to = Square::D5, .piece = Piece::WhiteRook, .captured = Piece::BlackPawn};
+    CHECK(defended_pawn.see(rook_takes_pawn) == -400);
+    CHECK_FALSE(defended_pawn.see_ge(rook_takes_pawn));
+    CHECK(defended_pawn.see_ge(rook_takes_pawn, -400));
+}
+
+TEST_CASE("Position.SEE.Quiet Move", "[position][see]") {
+    const Position position{FenString{"4k3/8/2p5/8/8/8/8/3RK3 w - - 0 1"}};
+    const Move safe{.from = Square::D1, .to = Square::D4, .piece = Piece::WhiteRook};
+    CHECK(position.see(safe) == 0);
+    const Move hanging{.from = Square::D1, .to = Square::D5, .piece = Piece::WhiteRook};
+    CHECK(position.see(hanging) == -500);
+}
+
+TEST_CASE("Position.SEE.X-Ray", "[position][see]") {
+    const Position position{FenString{"4k3/4r3/8/4p3/8/8/4R3/4R1K1 w - - 0 1"}};
+    const Move rook_takes_pawn{.from = Square::E2, .to = Square::E5, .piece = Piece::WhiteRook, .captured = Piece::BlackPawn};
+    CHECK(position.see(rook_takes_pawn) == 100);
+
+    const Position behind_pawn{FenString{"4k3/8/8/3p4/4P3/5Q2/8/4K3 w - - 0 1"}};
+    const Move pawn_takes_pawn{.from = Square::E4, .to = Square::D5, .piece = Piece::WhitePawn, .captured = Piece::BlackPawn};
+    CHECK(behind_pawn.see(pawn_takes_pawn) == 100);
+}
+
+TEST_CASE("Position.SEE.King Recapture", "[position][see]") {
+    const Position king_recaptures{FenString{"4k3/8/8/8/1b6/4K3/3p4/1N6 w - - 0 1"}};
+    const Move knight_takes_pawn{.from = Square::B1, .to = Square::D2, .piece = Piece::WhiteKnight, .captured = Piece::BlackPawn};
+    CHECK(king_recaptures.see(knight_takes_pawn) == 100);
+
+    const Position rook_defends{FenString{"3rk3/8/8/8/1b6/4K3/3p4/1N6 w - - 0 1"}};
+    CHECK(rook_defends.see(knight_takes_pawn) == -200);
+}
+
+TEST_CASE("Position.SEE.Promotion and En Passant", "[position][see]") {
+    const Position promotion{FenString{"3r3k/4P3/8/8/8/8/8/4K3 w - - 0 1"}};
+    const Move promote{.from = Square::E7, .to = Square::D8, .piece = Piece::WhitePawn, .captured = Piece::BlackRook, .promoted = Piece::WhiteQueen};
+    CHECK(promotion.see(promote) == 1300);
+
+    const Position en_passant{FenString{"4k3/8/8/3pP3/8/8/8/4K3 w - d6 0 1"}};
+    const Move capture{.from = Square::E5, .to = Square::D6, .piece = Piece::WhitePawn, .captured = Piece::BlackPawn, .capturing_en_passant = true};
+    CHECK(en_passant.see(capture) == 100);
+}
+
+TEST_CASE("Position.SEE.Pinned Defender", "[position][see]") {
+    // the knight on c6 is pinned against its king and cannot recapture on d4
+    const Position position{FenString{"4k3/8/2n5/1B6/3p4/8/8/3RK3 w - - 0 1"}};
+    const Move rook_takes_pawn{.from = Square::D1, .to = Square::D4, .piece = Piece::WhiteRook, .captured = Piece::BlackPawn};
+    CHECK(position.see(rook_takes_pawn) == 100);
+}
@@ -0,0 +1,181 @@
+/* ************************************************************************** *
+ * Chess Core                                                                 *
+ * Data structures and algorithms for chess                                   *
+ * ************************************************************************** */
+
+#include <catch2/catch_all.hpp>
+
+#include "chesscore/position.h"
+#include "chesscore/search.h"
+
+#include <atomic>
+#include <chrono>
+#include <set>
+#include <string>
+#include <thread>
+
+using namespace chesscore;
+using namespace chesscore::search;
+
+namespace {
+
+auto plays_legally(Position position, const MoveList &line) -> bool {
+    for (const auto &move : line) {
+        if (!position.is_legal(move)) {
+            return false;
+        }
+        position.make_move(move);
+    }
+    return true;
+}
+
+} // namespace
+
+TEST_CASE("Search.Evaluate", "[Search]") {
+    const auto start = Position::start_position();
+    CHECK(evaluate(start) == 0);
+
+    const Position white_up{FenString{"4k3/8/8/8/8/8/8/3QK3 w - - 0 1"}};
+    const Position black_to_move{FenString{"4k3/8/8/8/8/8/8/3QK3 b - - 0 1"}};
+    CHECK(evaluate(white_up) > 800);
+    CHECK(evaluate(black_to_move) == -evaluate(white_up));
+}
+
+TEST_CASE("Search.Mate Scores", "[Search]") {
+    CHECK(is_mate_score(mate_score - 1));
+    CHECK(is_mate_score(-mate_score + 4));
+    CHECK_FALSE(is_mate_score(900));
+    CHECK(mate_in(mate_score - 1) == 1);
+    CHECK(mate_in(mate_score - 3) == 2);
+    CHECK(mate_in(-mate_score + 2) == -1);
+}
+
+TEST_CASE("Search.Mate In One", "[Search]") {
+    Searcher searcher{1};
+    const Position position{FenString{"r1bqkb1r/pppp1ppp/2n2n2/4p2Q/2B1P3/8/PPPP1PPP/RNB1K1NR w KQkq - 4 4"}};
+    const auto result = searcher.search(position, Limits{.depth = 3});
+    REQUIRE(result.best_move.has_value());
+    CHECK(result.best_move->from == Square::H5);
+    CHECK(result.best_move->to == Square::F7);
+    CHECK(mate_in(result.score) == 1);
+    CHECK(result.pv.size() == 1);
+}
+
+TEST_CASE("Search.Mate In Two", "[Search]") {
+    Searcher searcher{1};
+    const Position position{FenString{"7k/8/8/8/8/8/R7/1R4K1 w - - 0 1"}};
+    const auto result = searcher.search(position, Limits{.depth = 5});
+    REQUIRE(result.best_move.has_value());
+    CHECK(is_mate_score(result.score));
+    CHECK(mate_in(result.score) == 2);
+    CHECK(result.pv.size() == 3);
+    CHECK(plays_legally(position, result.pv));
+}
+
+TEST_CASE("Search.Wins Material", "[Search]") {
+    Searcher searcher{1};
+    const Position position{FenString{"4k3/8/8/3q4/8/8/3R4/4K3 w - - 0 1"}};
+    const auto result = searcher.search(position, Limits{.depth = 4});
+    REQUIRE(result.best_move.has_value());
+    CHECK(result.best_move->to == Square::D5);
+    CHECK(result.score > 300);
+    CHECK(result.depth == 4);
+    CHECK(result.nodes > 0);
+}
+
+TEST_CASE("Search.No Legal Moves", "[Search]") {
+    Searcher searcher{1};
+    const Position mated{FenString{"R5k1/5ppp/8/8/8/8/8/6K1 b - - 1 1"}};
+    const auto mated_result = searcher.search(mated, Limits{.depth = 3});
+    CHECK_FALSE(mated_result.best_move.has_value());
+    CHECK(mated_result.score == -mate_score);
+    CHECK(mated_result.lines.empty());
+
+    const Position stalemate{FenString{"7k/5Q2/6K1/8/8/8/8/8 b - - 0 1"}};
+    const auto stalemate_result = searcher.search(stalemate, Limits{.depth = 3});
+    CHECK_FALSE(stalemate_result.best_move.has_value());
+    CHECK(stalemate_result.score == 0);
+}
+
+TEST_CASE("Search.Multi PV", "[Search]") {
+    Searcher searcher{4};
+    const auto position = Position::start_position();
+    const auto result = searcher.search(position, Limits{.depth = 4, .multi_pv = 3});
+    REQUIRE(result.lines.size() == 3);
+    std::set<std::string> first_moves;
+    for (std::size_t index = 0; index < result.lines.size(); ++index) {
+        const auto &line = result.lines[index];
+        REQUIRE_FALSE(line.moves.empty());
+        first_moves.insert(to_string(line.moves.front()));
+        CHECK(plays_legally(position, line.moves));
+        if (index > 0) {
+            CHECK(line.score <= result.lines[index - 1].score);
+        }
+    }
+    CHECK(first_moves.size() == 3);
+    CHECK(result.pv == result.lines.front().moves);
+    CHECK(result.score == result.lines.front().score);
+}
+
+TEST_CASE("Search.Limits", "[Search]") {
+    Searcher searcher{4};
+    const auto position = Position::start_position();
+
+    const auto node_limited = searcher.search(position, Limits{.nodes = 20000});
+    REQUIRE(node_limited.best_move.has_value());
+    CHECK(node_limited.depth >= 1);
+    CHECK(node_limited.nodes < 40000);
+
+    const auto started = std::chrono::steady_clock::now();
+    const auto time_limited = searcher.search(position, Limits{.time = std::chrono::milliseconds{100}});
+    CHECK(std::chrono::steady_clock::now() - started < std::chrono::seconds{2});
+    REQUIRE(time_limited.best_move.has_value());
+    CHECK(plays_legally(position, time_limited.pv));
+}
+
+TEST_CASE("Search.Stop", "[Search]") {
+    Searcher searcher{4};
+    const auto position = Position::start_position();
+    std::atomic<bool> finished{false};
+    Result result{};
+    std::thread thread{[&] {
+        result = searcher.search(position, Limits{});
+        finished.store(true);
+    }};
+    // a stop before the search started is ignored, so repeat it
+    while (!finished.load()) {
+        searcher.stop();
+        std::this_thread::sleep_for(std::chrono::milliseconds{1});
+    }
+    thread.join();
+    REQUIRE(result.best_move.has_value());
+    CHECK(result.depth >= 1);
+    CHECK(result.depth < max_depth);
+}
+
+TEST_CASE("Search.Stop While Idle", "[Search]") {
+    Searcher searcher{4};
+    const auto position = Position::start_position();
+    searcher.stop();
+    const auto first = searcher.search(position, Limits{.depth = 3});
+    CHECK(first.depth == 3);
+
+    searcher.stop();
+    const auto next = searcher.search(position, Limits{.depth = 4});
+    CHECK(next.depth == 4);
+}
+
+TEST_CASE("Search.Threads", "[Search]") {
+    Searcher searcher{4};
+    const Position position{FenString{"7k/8/8/8/8/8/R7/1R4K1 w - - 0 1"}};
+    const auto result = searcher.search(position, Limits{.depth = 5, .threads = 4});
+    REQUIRE(result.best_move.has_value());
+    CHECK(mate_in(result.score) == 2);
+    CHECK(plays_legally(position, result.pv));
+
+    const auto kiwipete = Position{FenString{"r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1"}};
+    const auto parallel = searcher.search(kiwipete, Limits{.depth = 5, .threads = 3});
+    REQUIRE(parallel.best_move.has_value());
+    CHECK(parallel.depth == 5);
+    CHECK(plays_legally(kiwipete, parallel.pv));
+}